@@ -0,0 +1,308 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+#include "glm.hpp"
+
+#include "hyperplane.h"
+
+namespace four
+{
+
+    namespace bvh
+    {
+
+        /// An axis-aligned bounding box in 4-space.
+        struct Bounds
+        {
+            glm::vec4 min{ std::numeric_limits<float>::max() };
+            glm::vec4 max{ std::numeric_limits<float>::lowest() };
+
+            /// Returns the bounds of all of the `points`.
+            static Bounds from_points(const std::vector<glm::vec4>& points)
+            {
+                Bounds bounds;
+                for (const auto& point : points)
+                {
+                    bounds.min = glm::min(bounds.min, point);
+                    bounds.max = glm::max(bounds.max, point);
+                }
+                return bounds;
+            }
+
+            glm::vec4 get_center() const
+            {
+                return (min + max) * 0.5f;
+            }
+
+            glm::vec4 get_half_extents() const
+            {
+                return (max - min) * 0.5f;
+            }
+
+            /// Grows these bounds to contain `other` as well.
+            void merge(const Bounds& other)
+            {
+                min = glm::min(min, other.min);
+                max = glm::max(max, other.max);
+            }
+
+            /// Returns the bounds of these bounds after being transformed by `transform` and then translated by
+            /// `translation` (which are generally larger than the bounds of the transformed points themselves).
+            Bounds transformed(const glm::mat4& transform, const glm::vec4& translation) const
+            {
+                // Each half extent of the result is the sum of the (absolute) contributions of every axis of the original
+                // box, i.e. |T| * h (see Arvo, "Transforming Axis-Aligned Bounding Boxes")
+                glm::mat4 absolute;
+                for (int column = 0; column < 4; ++column)
+                {
+                    absolute[column] = glm::abs(transform[column]);
+                }
+                const glm::vec4 center = transform * get_center() + translation;
+                const glm::vec4 half_extents = absolute * get_half_extents();
+
+                return { center - half_extents, center + half_extents };
+            }
+
+            /// Returns `true` if these bounds straddle (or touch) `hyperplane`: the box's projection onto the normal is
+            /// an interval of radius `|n| . h` around the projection of its center.
+            bool intersects(const Hyperplane& hyperplane, float epsilon = 0.0001f) const
+            {
+                const float radius = glm::dot(glm::abs(hyperplane.normal), get_half_extents());
+                return std::abs(hyperplane.signed_distance(get_center())) <= radius + epsilon;
+            }
+        };
+
+        /// A bounding hypersphere in 4-space.
+        struct Sphere
+        {
+            glm::vec4 center{ 0.0f };
+            float radius = 0.0f;
+
+            /// Returns a sphere that contains all of the `points`, centered at the center of their bounds.
+            static Sphere from_points(const std::vector<glm::vec4>& points)
+            {
+                Sphere sphere;
+                sphere.center = Bounds::from_points(points).get_center();
+                for (const auto& point : points)
+                {
+                    sphere.radius = std::max(sphere.radius, glm::length(point - sphere.center));
+                }
+                return sphere;
+            }
+
+            /// Returns a sphere that contains this sphere after being transformed by `transform` and then translated by 
+            /// `translation`: the radius is scaled by sqrt(|T|_1 * |T|_inf), which bounds how much `transform` can stretch 
+            /// any vector (i.e. its largest singular value).
+            Sphere transformed(const glm::mat4& transform, const glm::vec4& translation) const
+            {
+                float max_column_sum = 0.0f;
+                float max_row_sum = 0.0f;
+                for (int i = 0; i < 4; ++i)
+                {
+                    float column_sum = 0.0f;
+                    float row_sum = 0.0f;
+                    for (int j = 0; j < 4; ++j)
+                    {
+                        column_sum += std::abs(transform[i][j]);
+                        row_sum += std::abs(transform[j][i]);
+                    }
+                    max_column_sum = std::max(max_column_sum, column_sum);
+                    max_row_sum = std::max(max_row_sum, row_sum);
+                }
+                return { transform * center + translation, radius * std::sqrt(max_column_sum * max_row_sum) };
+            }
+
+            bool intersects(const Hyperplane& hyperplane, float epsilon = 0.0001f) const
+            {
+                return std::abs(hyperplane.signed_distance(center)) <= radius + epsilon;
+            }
+        };
+
+        /// A 3D view frustum, as the 6 planes `(n, d)` with `dot(n, p) + d >= 0` for every point `p` inside of it. A default
+        /// constructed frustum contains everything.
+        struct Frustum
+        {
+            std::array<glm::vec4, 6> planes{ {
+                glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f },
+                glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f },
+                glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f },
+                glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f },
+                glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f },
+                glm::vec4{ 0.0f, 0.0f, 0.0f, 1.0f }
+            } };
+
+            /// Returns the frustum of the (3D) view-projection matrix `clip_from_world`, i.e. the region that is mapped inside
+            /// of the clip volume (see Gribb and Hartmann, "Fast Extraction of Viewing Frustum Planes").
+            static Frustum from_matrix(const glm::mat4& clip_from_world)
+            {
+                const auto row = [&](int i)
+                {
+                    return glm::vec4{ clip_from_world[0][i], clip_from_world[1][i], clip_from_world[2][i], clip_from_world[3][i] };
+                };
+
+                Frustum frustum;
+                for (int axis = 0; axis < 3; ++axis)
+                {
+                    frustum.planes[axis * 2 + 0] = row(3) + row(axis);
+                    frustum.planes[axis * 2 + 1] = row(3) - row(axis);
+                }
+                return frustum;
+            }
+
+            /// Returns `true` unless the xyz-extents of `bounds` (i.e. their orthographic projection along w, which is
+            /// how slices are projected into 3-space) lie entirely outside of one of the planes.
+            bool intersects(const Bounds& bounds) const
+            {
+                for (const auto& plane : planes)
+                {
+                    // The corner of the box that is furthest along the plane's normal
+                    const glm::vec3 corner{
+                        plane.x > 0.0f ? bounds.max.x : bounds.min.x,
+                        plane.y > 0.0f ? bounds.max.y : bounds.min.y,
+                        plane.z > 0.0f ? bounds.max.z : bounds.min.z
+                    };
+                    if (glm::dot(glm::vec3{ plane }, corner) + plane.w < 0.0f)
+                    {
+                        return false;
+                    }
+                }
+                return true;
+            }
+        };
+
+        /// A bounding volume hierarchy over a set of (indexed) bounding boxes, which is built top-down by splitting each
+        /// node at the median of its longest axis. Each node is either an interior node with exactly 2 children, or a leaf
+        /// that refers to a range of `indices`.
+        class Tree
+        {
+
+        public:
+
+            Tree() = default;
+
+            explicit Tree(const std::vector<Bounds>& leaves) :
+                leaves{ leaves }
+            {
+                indices.resize(leaves.size());
+                std::iota(indices.begin(), indices.end(), 0);
+
+                if (!leaves.empty())
+                {
+                    nodes.emplace_back();
+                    build(0, 0, indices.size());
+                }
+            }
+
+            /// Calls `visit` with the index of every leaf whose bounds straddle `hyperplane`, skipping entire subtrees whose
+            /// bounds lie on one side of it.
+            template<class Visitor>
+            void query(const Hyperplane& hyperplane, Visitor visit) const
+            {
+                if (nodes.empty())
+                {
+                    return;
+                }
+
+                std::vector<uint32_t> stack{ 0 };
+                while (!stack.empty())
+                {
+                    const auto& node = nodes[stack.back()];
+                    stack.pop_back();
+
+                    if (!node.bounds.intersects(hyperplane))
+                    {
+                        continue;
+                    }
+
+                    if (node.count > 0)
+                    {
+                        for (uint32_t i = node.first; i < node.first + node.count; ++i)
+                        {
+                            if (leaves[indices[i]].intersects(hyperplane))
+                            {
+                                visit(indices[i]);
+                            }
+                        }
+                    }
+                    else
+                    {
+                        stack.push_back(node.first);
+                        stack.push_back(node.first + 1);
+                    }
+                }
+            }
+
+        private:
+
+            /// An interior node (`count == 0`) whose children are at `first` and `first + 1`, or a leaf that contains
+            /// `indices[first]` up to (but not including) `indices[first + count]`.
+            struct Node
+            {
+                Bounds bounds;
+                uint32_t first = 0;
+                uint32_t count = 0;
+            };
+
+            /// The maximum number of leaves in each leaf node.
+            static const size_t max_leaves_per_node = 2;
+
+            /// Builds the subtree (rooted at the node at `node_index`) over `indices[begin]` up to (but not including) `indices[end]`.
+            void build(uint32_t node_index, size_t begin, size_t end)
+            {
+                Bounds bounds;
+                for (size_t i = begin; i < end; ++i)
+                {
+                    bounds.merge(leaves[indices[i]]);
+                }
+                nodes[node_index].bounds = bounds;
+
+                if (end - begin <= max_leaves_per_node)
+                {
+                    nodes[node_index].first = static_cast<uint32_t>(begin);
+                    nodes[node_index].count = static_cast<uint32_t>(end - begin);
+                    return;
+                }
+
+                // Split at the median of the longest axis (of the leaves' centers)
+                const glm::vec4 extents = bounds.max - bounds.min;
+                int axis = 0;
+                for (int i = 1; i < 4; ++i)
+                {
+                    if (extents[i] > extents[axis])
+                    {
+                        axis = i;
+                    }
+                }
+
+                const size_t middle = (begin + end) / 2;
+                std::nth_element(indices.begin() + begin, indices.begin() + middle, indices.begin() + end, [&](uint32_t a, uint32_t b)
+                {
+                    return leaves[a].get_center()[axis] < leaves[b].get_center()[axis];
+                });
+
+                // Both children are allocated next to each other, so that an interior node only needs to store the first
+                const uint32_t children = static_cast<uint32_t>(nodes.size());
+                nodes.emplace_back();
+                nodes.emplace_back();
+                nodes[node_index].first = children;
+
+                build(children, begin, middle);
+                build(children + 1, middle, end);
+            }
+
+            std::vector<Bounds> leaves;
+            std::vector<uint32_t> indices;
+            std::vector<Node> nodes;
+
+        };
+
+    }
+
+}
\ No newline at end of file
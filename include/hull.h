@@ -0,0 +1,192 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <map>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "glm.hpp"
+#include "libqhullcpp/Qhull.h"
+#include "libqhullcpp/QhullFacetList.h"
+#include "libqhullcpp/QhullVertexSet.h"
+
+#include "lattice.h"
+#include "locality.h"
+#include "simd.h"
+#include "tetrahedra.h"
+
+namespace four
+{
+
+    namespace hull
+    {
+
+        /// The options that QHull is run with (these are part of each mesh's cache key, see `mesh_cache.h`)
+        const char* const qhull_options = "Qt";
+
+        double round_nearest_tenth(double x)
+        {
+            return floor(x * 10.0 + 0.5) / 10.0;
+        }
+
+        /// Runs QHull on the 4-dimensional `points` and converts the resulting (triangulated)
+        /// convex hull into a set of tetrahedra that can be handed to the renderer. Note that
+        /// all of the points are projected onto the unit 3-sphere. If `find_edges` is `true`,
+        /// the edges of the polychoron (and of each of its cells) will be found as well, along
+        /// with the number of faces of each cell (see `lattice.h`). 
+        ///
+        /// All diagnostic output is written to `log`, and `report_progress` (if provided) is
+        /// periodically called with the fraction of the work that has been completed so far.
+        /// This function is safe to call from multiple threads at once. Any error (e.g. from QHull,
+        /// or a non-simplicial facet) is thrown rather than logged, so that a partially built mesh
+        /// is never returned (and hence, never uploaded or written to the mesh cache).
+        Tetrahedra build_tetrahedra(const std::vector<glm::vec4>& points, 
+                                    bool find_edges = true, 
+                                    std::ostream& log = std::cout, 
+                                    const std::function<void(float)>& report_progress = nullptr)
+        {
+            const auto report = [&](float fraction)
+            {
+                if (report_progress)
+                {
+                    report_progress(fraction);
+                }
+            };
+
+            std::vector<double> coordinates;
+            coordinates.reserve(points.size() * 4);
+            for (const auto& point : points)
+            {
+                coordinates.push_back(point[0]);
+                coordinates.push_back(point[1]);
+                coordinates.push_back(point[2]);
+                coordinates.push_back(point[3]);
+            }
+
+            // Initialize QHull
+            orgQhull::Qhull qhull;
+
+            std::vector<glm::vec4> vertices;
+            std::vector<uint32_t> simplices;
+            std::vector<uint32_t> edges;
+            std::vector<glm::vec4> normals;
+
+            // The cell (i.e. merged facet) that each simplex belongs to
+            std::vector<uint32_t> cell_indices;
+            std::vector<uint32_t> cell_offsets;
+            std::vector<uint32_t> cell_edges;
+            std::vector<uint32_t> cell_face_offsets;
+            std::map<std::array<double, 5>, uint32_t> hyperplane_to_cell;
+
+            // Run QHull
+            const bool triangulate = true;
+            if (triangulate)
+            { 
+                qhull.runQhull("", 4, points.size(), coordinates.data(), qhull_options); 
+            }
+            else 
+            {
+                // Merge coplanar facets within an epsilon 
+                qhull.runQhull("", 4, points.size(), coordinates.data(), "C0.001"); 
+            }
+
+            report(0.5f);
+
+            // Process unique points that form the convex hull (projecting them onto the unit hypersphere as a batch)
+            simd::Points hull_points{ static_cast<size_t>(qhull.points().count()) };
+            size_t point_index = 0;
+            for (const auto& point : qhull.points())
+            {
+                auto coords = point.coordinates();
+                assert(point.dimension() == 4);
+
+                hull_points.set(point_index++, glm::vec4{ coords[0], coords[1], coords[2], coords[3] });
+            }
+            simd::normalize(hull_points);
+            vertices = hull_points.to_vec4s();
+
+            // Process unique facets that form the convex hull
+            log << "\t" << "Facet count: " << qhull.facetList().count() << std::endl;
+            for (auto& face : qhull.facetList())
+            {
+                if (!face.isSimplicial())
+                {
+                    throw std::runtime_error("Non-simplical face found");
+                }
+                for (const auto& vertex : face.vertices())
+                {
+                    simplices.push_back(vertex.point().id());
+                }
+
+                auto hyperplane = face.hyperplane();
+                auto center = face.getCenter();
+                auto normal = hyperplane.coordinates();
+                assert(hyperplane.dimension() == 4);
+
+                // When QHull triangulates a merged facet, each of the resulting simplices shares the original facet's 
+                // hyperplane, so identical hyperplanes can be used to group simplices back into cells
+                const std::array<double, 5> key = { normal[0], normal[1], normal[2], normal[3], hyperplane.offset() };
+                auto [iter, inserted] = hyperplane_to_cell.insert({ key, static_cast<uint32_t>(hyperplane_to_cell.size()) });
+                cell_indices.push_back(iter->second);
+
+                normals.push_back(glm::normalize(glm::vec4{
+                    round_nearest_tenth(normal[0]),
+                    round_nearest_tenth(normal[1]),
+                    round_nearest_tenth(normal[2]),
+                    round_nearest_tenth(normal[3])
+                }));
+            }
+
+            log << "\t" << "Convex hull resulted in:" << std::endl;
+            log << "\t - " << vertices.size() << " vertices" << std::endl;
+            log << "\t - " << simplices.size() / 4 << " simplices" << std::endl;
+            log << "\t - " << normals.size() << " hyperplane normals" << std::endl;
+            report(0.6f);
+
+            if (find_edges)
+            {
+                // The edges are derived from the face lattice, which is exact for any convex polychoron
+                const auto face_lattice = lattice::build(simplices, cell_indices, vertices.size());
+                const auto f_vector = face_lattice.get_f_vector();
+                log << "\t" << "f-vector: (" << f_vector[0] << ", " << f_vector[1] << ", " << f_vector[2] << ", " << f_vector[3] << ")" << std::endl;
+                log << "\t" << "Euler characteristic: " << face_lattice.get_euler_characteristic() << std::endl;
+
+                edges = face_lattice.edge_vertices.indices;
+                cell_offsets = face_lattice.cell_edges.offsets;
+                for (const auto& edge : face_lattice.cell_edges.indices)
+                {
+                    cell_edges.push_back(face_lattice.edge_vertices[edge][0]);
+                    cell_edges.push_back(face_lattice.edge_vertices[edge][1]);
+                }
+
+                // The renderer sizes its cell slices by the number of faces of each cell
+                cell_face_offsets = face_lattice.cell_faces.offsets;
+            }
+
+            Tetrahedra tetrahedra{
+                vertices,
+                simplices,
+                edges,
+                normals,
+                cell_indices,
+                cell_offsets,
+                cell_edges,
+                cell_face_offsets
+            };
+
+            // Store nearby vertices and tetrahedra close together in memory (see `locality.h`)
+            locality::reorder(tetrahedra, log);
+            report(1.0f);
+
+            return tetrahedra;
+        }
+
+    }
+
+}
\ No newline at end of file
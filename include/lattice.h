@@ -0,0 +1,404 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "tetrahedra.h"
+
+namespace four
+{
+
+    namespace lattice
+    {
+
+        /// An incidence relation between two kinds of elements (for example, faces and the edges that bound them), stored
+        /// in compressed sparse row (CSR) format: the elements incident to element `i` are `indices[offsets[i]]` up to (but
+        /// not including) `indices[offsets[i + 1]]`.
+        struct Incidence
+        {
+            std::vector<uint32_t> offsets{ 0 };
+            std::vector<uint32_t> indices;
+
+            /// Returns the number of elements (rows) in this relation.
+            size_t size() const
+            {
+                return offsets.size() - 1;
+            }
+
+            /// Returns all of the elements that are incident to element `i` in O(1).
+            Span<uint32_t> operator[](size_t i) const
+            {
+                return { indices.data() + offsets[i], offsets[i + 1] - offsets[i] };
+            }
+
+            /// Appends a new element (row), which is incident to all of the elements in `[begin, end)`.
+            template<class Iterator>
+            void push_back(Iterator begin, Iterator end)
+            {
+                indices.insert(indices.end(), begin, end);
+                offsets.push_back(static_cast<uint32_t>(indices.size()));
+            }
+
+            /// Returns the inverse of this relation (i.e. if this maps faces to edges, the transpose maps edges to faces),
+            /// where `number_of_targets` is the number of elements that can appear in `indices`. This is a counting sort,
+            /// so it runs in linear time, and each row of the result is sorted.
+            Incidence transpose(size_t number_of_targets) const
+            {
+                Incidence result;
+                result.offsets.assign(number_of_targets + 1, 0);
+                for (const auto& index : indices)
+                {
+                    result.offsets[index + 1]++;
+                }
+                for (size_t i = 0; i < number_of_targets; ++i)
+                {
+                    result.offsets[i + 1] += result.offsets[i];
+                }
+
+                auto next = result.offsets;
+                result.indices.resize(indices.size());
+                for (size_t row = 0; row < size(); ++row)
+                {
+                    for (const auto& index : (*this)[row])
+                    {
+                        result.indices[next[index]++] = static_cast<uint32_t>(row);
+                    }
+                }
+
+                return result;
+            }
+        };
+
+        /// The face lattice of a convex polychoron: its vertices (V), edges (E), 2-dimensional faces (F), and cells (C),
+        /// along with all of the incidences between neighboring ranks (in both directions). Vertices are identified by
+        /// their index in the corresponding `Tetrahedra`, while edges, faces, and cells are numbered from zero.
+        struct FaceLattice
+        {
+            /// The 2 vertices of each edge (sorted): edges themselves are sorted lexicographically by their vertices (note that
+            /// `locality::reorder(...)` renumbers the vertices of the edges that `hull::build_tetrahedra(...)` keeps, after which
+            /// neither of these holds)
+            Incidence edge_vertices;
+
+            /// The vertices of each face, in cyclic order around the face
+            Incidence face_vertices;
+
+            /// The edges of each face, in the same cyclic order: edge `j` connects vertices `j` and `j + 1` of the face
+            Incidence face_edges;
+
+            /// The faces of each cell
+            Incidence cell_faces;
+
+            /// The (sorted) edges of each cell
+            Incidence cell_edges;
+
+            /// The (sorted) vertices of each cell
+            Incidence cell_vertices;
+
+            /// The edges that meet at each vertex
+            Incidence vertex_edges;
+
+            /// The faces that meet at each edge
+            Incidence edge_faces;
+
+            /// The 2 cells that meet at each face
+            Incidence face_cells;
+
+            /// The cells that meet at each vertex
+            Incidence vertex_cells;
+
+            /// Returns the number of vertices, edges, faces, and cells, in that order. Note that only vertices that are
+            /// part of at least one edge are counted.
+            std::array<size_t, 4> get_f_vector() const
+            {
+                size_t number_of_vertices = 0;
+                for (size_t i = 0; i < vertex_edges.size(); ++i)
+                {
+                    if (!vertex_edges[i].empty())
+                    {
+                        number_of_vertices++;
+                    }
+                }
+
+                return { number_of_vertices, edge_vertices.size(), face_vertices.size(), cell_faces.size() };
+            }
+
+            /// Returns `V - E + F - C`, which is 0 for any convex polychoron (since its boundary is a 3-sphere).
+            int64_t get_euler_characteristic() const
+            {
+                const auto f_vector = get_f_vector();
+
+                return static_cast<int64_t>(f_vector[0]) -
+                       static_cast<int64_t>(f_vector[1]) +
+                       static_cast<int64_t>(f_vector[2]) -
+                       static_cast<int64_t>(f_vector[3]);
+            }
+        };
+
+        /// Builds the face lattice of a convex polychoron whose boundary has been triangulated into `simplices` (4 vertex
+        /// indices per tetrahedron), where `cell_indices` holds the cell that each tetrahedron is part of. All vertex indices
+        /// must be less than `number_of_vertices`.
+        ///
+        /// Two cells are adjacent if any of their tetrahedra share a triangle, in which case the vertices they have in common
+        /// form a face. Two faces of the same cell that share exactly 2 vertices meet along an edge. Since only faces that
+        /// share a vertex are ever compared, this runs in time linear in the size of the lattice (for cells of bounded size).
+        FaceLattice build(const Span<uint32_t>& simplices, const Span<uint32_t>& cell_indices, size_t number_of_vertices)
+        {
+            FaceLattice lattice;
+            if (cell_indices.empty())
+            {
+                lattice.vertex_edges.offsets.assign(number_of_vertices + 1, 0);
+                lattice.vertex_cells.offsets.assign(number_of_vertices + 1, 0);
+                return lattice;
+            }
+            if (number_of_vertices >= (1u << 21))
+            {
+                throw std::runtime_error("Too many vertices to build triangle keys");
+            }
+
+            const size_t number_of_cells = *std::max_element(cell_indices.begin(), cell_indices.end()) + 1;
+
+            // Gather the (sorted, unique) vertices of each cell
+            {
+                Incidence cell_simplices;
+                Incidence simplex_cells;
+                for (const auto& cell : cell_indices)
+                {
+                    simplex_cells.push_back(&cell, &cell + 1);
+                }
+                cell_simplices = simplex_cells.transpose(number_of_cells);
+
+                std::vector<uint32_t> vertices;
+                for (size_t cell = 0; cell < number_of_cells; ++cell)
+                {
+                    vertices.clear();
+                    for (const auto& simplex_index : cell_simplices[cell])
+                    {
+                        vertices.insert(vertices.end(), simplices.begin() + simplex_index * 4, simplices.begin() + simplex_index * 4 + 4);
+                    }
+                    std::sort(vertices.begin(), vertices.end());
+                    vertices.erase(std::unique(vertices.begin(), vertices.end()), vertices.end());
+
+                    lattice.cell_vertices.push_back(vertices.begin(), vertices.end());
+                }
+            }
+
+            // Every triangle on the boundary of the polychoron is shared by exactly 2 tetrahedra: if these belong to
+            // different cells, the cells are adjacent
+            std::vector<std::pair<uint32_t, uint32_t>> adjacent_cells;
+            {
+                std::unordered_map<uint64_t, uint32_t> triangle_to_cell;
+                triangle_to_cell.reserve(cell_indices.size() * 2);
+                for (size_t simplex_index = 0; simplex_index < cell_indices.size(); ++simplex_index)
+                {
+                    std::array<uint32_t, 4> simplex;
+                    std::copy(simplices.begin() + simplex_index * 4, simplices.begin() + simplex_index * 4 + 4, simplex.begin());
+                    std::sort(simplex.begin(), simplex.end());
+
+                    for (size_t skip = 0; skip < 4; ++skip)
+                    {
+                        // Pack the 3 (sorted) vertex IDs of this triangle into a single key
+                        uint64_t key = 0;
+                        for (size_t i = 0; i < 4; ++i)
+                        {
+                            if (i != skip)
+                            {
+                                key = (key << 21) | simplex[i];
+                            }
+                        }
+
+                        const uint32_t cell = cell_indices[simplex_index];
+                        auto [iter, inserted] = triangle_to_cell.insert({ key, cell });
+                        if (!inserted && iter->second != cell)
+                        {
+                            adjacent_cells.push_back({ std::min(cell, iter->second), std::max(cell, iter->second) });
+                        }
+                    }
+                }
+                std::sort(adjacent_cells.begin(), adjacent_cells.end());
+                adjacent_cells.erase(std::unique(adjacent_cells.begin(), adjacent_cells.end()), adjacent_cells.end());
+            }
+
+            // Build the faces (as unordered vertex sets, for now)
+            Incidence face_vertex_sets;
+            std::vector<uint32_t> shared;
+            for (const auto& [a, b] : adjacent_cells)
+            {
+                shared.clear();
+                std::set_intersection(lattice.cell_vertices[a].begin(), lattice.cell_vertices[a].end(),
+                                      lattice.cell_vertices[b].begin(), lattice.cell_vertices[b].end(),
+                                      std::back_inserter(shared));
+
+                face_vertex_sets.push_back(shared.begin(), shared.end());
+
+                const std::array<uint32_t, 2> cells = { a, b };
+                lattice.face_cells.push_back(cells.begin(), cells.end());
+            }
+            const size_t number_of_faces = face_vertex_sets.size();
+            lattice.cell_faces = lattice.face_cells.transpose(number_of_cells);
+
+            // Within each cell, find all pairs of faces that share exactly 2 vertices: the faces that meet at a vertex
+            // are found by transposing the cell's (local) face-vertex incidences
+            std::vector<std::array<uint32_t, 4>> edge_face_pairs;
+            {
+                std::vector<uint32_t> local_faces;
+                std::unordered_map<uint32_t, std::vector<uint32_t>> vertex_to_local_faces;
+                for (size_t cell = 0; cell < number_of_cells; ++cell)
+                {
+                    vertex_to_local_faces.clear();
+                    for (const auto& face : lattice.cell_faces[cell])
+                    {
+                        for (const auto& vertex : face_vertex_sets[face])
+                        {
+                            vertex_to_local_faces[vertex].push_back(face);
+                        }
+                    }
+
+                    for (const auto& face : lattice.cell_faces[cell])
+                    {
+                        // All of the other faces of this cell that touch this face (each pair is only considered once)
+                        local_faces.clear();
+                        for (const auto& vertex : face_vertex_sets[face])
+                        {
+                            for (const auto& other : vertex_to_local_faces[vertex])
+                            {
+                                if (other > face)
+                                {
+                                    local_faces.push_back(other);
+                                }
+                            }
+                        }
+                        std::sort(local_faces.begin(), local_faces.end());
+                        local_faces.erase(std::unique(local_faces.begin(), local_faces.end()), local_faces.end());
+
+                        for (const auto& other : local_faces)
+                        {
+                            shared.clear();
+                            std::set_intersection(face_vertex_sets[face].begin(), face_vertex_sets[face].end(),
+                                                  face_vertex_sets[other].begin(), face_vertex_sets[other].end(),
+                                                  std::back_inserter(shared));
+                            if (shared.size() == 2)
+                            {
+                                edge_face_pairs.push_back({ shared[0], shared[1], face, other });
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Number the edges in lexicographic order
+            std::vector<std::pair<uint32_t, uint32_t>> edges;
+            edges.reserve(edge_face_pairs.size());
+            for (const auto& [a, b, face, other] : edge_face_pairs)
+            {
+                edges.push_back({ a, b });
+            }
+            std::sort(edges.begin(), edges.end());
+            edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+            for (const auto& [a, b] : edges)
+            {
+                const std::array<uint32_t, 2> vertices = { a, b };
+                lattice.edge_vertices.push_back(vertices.begin(), vertices.end());
+            }
+            lattice.vertex_edges = lattice.edge_vertices.transpose(number_of_vertices);
+
+            const auto get_edge = [&](uint32_t a, uint32_t b)
+            {
+                return static_cast<uint32_t>(std::lower_bound(edges.begin(), edges.end(), std::make_pair(a, b)) - edges.begin());
+            };
+
+            // Gather the (unordered) edges of each face
+            Incidence face_edge_sets;
+            {
+                Incidence edge_face_incidences;
+                for (const auto& [a, b, face, other] : edge_face_pairs)
+                {
+                    const std::array<uint32_t, 2> faces = { face, other };
+                    edge_face_incidences.push_back(faces.begin(), faces.end());
+                }
+                auto face_edge_pairs = edge_face_incidences.transpose(number_of_faces);
+
+                std::vector<uint32_t> face_edges;
+                for (size_t face = 0; face < number_of_faces; ++face)
+                {
+                    face_edges.clear();
+                    for (const auto& pair_index : face_edge_pairs[face])
+                    {
+                        face_edges.push_back(get_edge(edge_face_pairs[pair_index][0], edge_face_pairs[pair_index][1]));
+                    }
+                    std::sort(face_edges.begin(), face_edges.end());
+                    face_edges.erase(std::unique(face_edges.begin(), face_edges.end()), face_edges.end());
+
+                    face_edge_sets.push_back(face_edges.begin(), face_edges.end());
+                }
+            }
+
+            // Walk around each face to put its vertices and edges into cyclic order
+            std::vector<uint32_t> cycle_vertices;
+            std::vector<uint32_t> cycle_edges;
+            for (size_t face = 0; face < number_of_faces; ++face)
+            {
+                const auto face_edges = face_edge_sets[face];
+                cycle_vertices.clear();
+                cycle_edges.clear();
+
+                if (!face_edges.empty())
+                {
+                    std::vector<bool> visited(face_edges.size(), false);
+                    uint32_t current = lattice.edge_vertices[face_edges[0]][0];
+                    for (size_t step = 0; step < face_edges.size(); ++step)
+                    {
+                        // Find the next unvisited edge that touches the current vertex
+                        for (size_t j = 0; j < face_edges.size(); ++j)
+                        {
+                            const auto vertices = lattice.edge_vertices[face_edges[j]];
+                            if (!visited[j] && (vertices[0] == current || vertices[1] == current))
+                            {
+                                visited[j] = true;
+                                cycle_vertices.push_back(current);
+                                cycle_edges.push_back(face_edges[j]);
+                                current = vertices[0] == current ? vertices[1] : vertices[0];
+                                break;
+                            }
+                        }
+                    }
+                }
+
+                lattice.face_vertices.push_back(cycle_vertices.begin(), cycle_vertices.end());
+                lattice.face_edges.push_back(cycle_edges.begin(), cycle_edges.end());
+            }
+            lattice.edge_faces = lattice.face_edges.transpose(edges.size());
+
+            // Gather the (sorted, unique) edges of each cell
+            std::vector<uint32_t> cell_edges;
+            for (size_t cell = 0; cell < number_of_cells; ++cell)
+            {
+                cell_edges.clear();
+                for (const auto& face : lattice.cell_faces[cell])
+                {
+                    cell_edges.insert(cell_edges.end(), lattice.face_edges[face].begin(), lattice.face_edges[face].end());
+                }
+                std::sort(cell_edges.begin(), cell_edges.end());
+                cell_edges.erase(std::unique(cell_edges.begin(), cell_edges.end()), cell_edges.end());
+
+                lattice.cell_edges.push_back(cell_edges.begin(), cell_edges.end());
+            }
+            lattice.vertex_cells = lattice.cell_vertices.transpose(number_of_vertices);
+
+            return lattice;
+        }
+
+        FaceLattice build(const TetrahedraView& tetrahedra)
+        {
+            return build(tetrahedra.simplices, tetrahedra.cell_indices, tetrahedra.vertices.size());
+        }
+
+    }
+
+}
\ No newline at end of file
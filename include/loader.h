@@ -0,0 +1,273 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tetrahedra.h"
+
+namespace four
+{
+
+    /// A lock-free, unbounded, multi-producer / single-consumer queue. Any number of threads
+    /// may call `push(...)`, but only one thread may call `try_pop(...)`.
+    ///
+    /// Reference: `https://www.1024cores.net/home/lock-free-algorithms/queues/non-intrusive-mpsc-node-based-queue`
+    template<class T>
+    class MpscQueue
+    {
+
+    public:
+
+        MpscQueue() :
+            head{ new Node{} },
+            tail{ head.load() }
+        {}
+
+        ~MpscQueue()
+        {
+            while (tail != nullptr)
+            {
+                Node* next = tail->next.load();
+                delete tail;
+                tail = next;
+            }
+        }
+
+        MpscQueue(const MpscQueue&) = delete;
+        MpscQueue& operator=(const MpscQueue&) = delete;
+
+        void push(T value)
+        {
+            Node* node = new Node{};
+            node->value = std::move(value);
+
+            // Swing the head to the new node, then link the previous head to it: until the link is
+            // made, the consumer simply sees a (temporarily) shorter queue
+            Node* previous = head.exchange(node, std::memory_order_acq_rel);
+            previous->next.store(node, std::memory_order_release);
+        }
+
+        bool try_pop(T& value)
+        {
+            Node* next = tail->next.load(std::memory_order_acquire);
+            if (next == nullptr)
+            {
+                return false;
+            }
+
+            // The node after the tail becomes the new "stub" node
+            value = std::move(next->value);
+            delete tail;
+            tail = next;
+
+            return true;
+        }
+
+    private:
+
+        struct Node
+        {
+            std::atomic<Node*> next{ nullptr };
+            T value;
+        };
+
+        /// The most recently pushed node (shared between all of the producers)
+        std::atomic<Node*> head;
+
+        /// A "stub" node that precedes the oldest node in the queue (only touched by the consumer)
+        Node* tail;
+    };
+
+    enum class LoadStatus
+    {
+        QUEUED,
+        BUILDING,
+        READY,
+        FAILED
+    };
+
+    /// The (thread-safe) progress of a single job: this is written by the worker threads and
+    /// read by the render thread in order to display progress bars.
+    struct LoadProgress
+    {
+        std::string name;
+        std::atomic<LoadStatus> status{ LoadStatus::QUEUED };
+        std::atomic<float> fraction{ 0.0f };
+    };
+
+    /// A finished job: `view` refers to memory that is kept alive by `storage` (either the `Tetrahedra` that
+    /// were built by the job, or something else entirely, like a memory-mapped cache file).
+    struct LoadResult
+    {
+        size_t id = 0;
+        TetrahedraView view;
+        std::shared_ptr<const void> storage;
+    };
+
+    /// A job-based loader that builds polychora on a pool of worker threads. Each finished
+    /// set of tetrahedra is handed back to the render thread via a lock-free queue, so that
+    /// it can be uploaded to the GPU as soon as it arrives.
+    class Loader
+    {
+
+    public:
+
+        /// A job receives a function that it can use to report its progress (0..1) and a stream
+        /// to write any diagnostic output to.
+        using Job = std::function<Tetrahedra(const std::function<void(float)>&, std::ostream&)>;
+
+        explicit Loader(size_t number_of_threads = std::max(std::thread::hardware_concurrency(), 2u) - 1)
+        {
+            for (size_t i = 0; i < number_of_threads; ++i)
+            {
+                workers.emplace_back([this] { run_worker(); });
+            }
+        }
+
+        ~Loader()
+        {
+            {
+                std::lock_guard<std::mutex> lock{ mutex };
+                stopping = true;
+            }
+            condition.notify_all();
+
+            for (auto& worker : workers)
+            {
+                worker.join();
+            }
+        }
+
+        Loader(const Loader&) = delete;
+        Loader& operator=(const Loader&) = delete;
+
+        /// Schedules `job` on the next available worker thread and returns its ID, which can be used
+        /// to look up its progress and match it with a result from `try_pop(...)`. This must be called
+        /// from the render thread.
+        size_t submit(const std::string& name, Job job)
+        {
+            auto load_progress = std::make_unique<LoadProgress>();
+            load_progress->name = name;
+            progress.push_back(std::move(load_progress));
+
+            const size_t id = progress.size() - 1;
+            {
+                std::lock_guard<std::mutex> lock{ mutex };
+                jobs.push_back({ id, std::move(job), progress.back().get() });
+            }
+            condition.notify_one();
+
+            return id;
+        }
+
+        /// Registers a job that has already been completed elsewhere (for example, a polychoron that was
+        /// loaded from the mesh cache), so that it gets an ID and shows up alongside all of the other jobs.
+        /// Its result (`view`, which must stay valid for as long as `storage` is alive) is returned from
+        /// `try_pop(...)` like any other, so that it is uploaded in turn. This must be called from the render thread.
+        size_t submit_completed(const std::string& name, const TetrahedraView& view, std::shared_ptr<const void> storage)
+        {
+            auto load_progress = std::make_unique<LoadProgress>();
+            load_progress->name = name;
+            load_progress->status = LoadStatus::READY;
+            load_progress->fraction = 1.0f;
+            progress.push_back(std::move(load_progress));
+
+            const size_t id = progress.size() - 1;
+            results.push({ id, view, std::move(storage) });
+
+            return id;
+        }
+
+        /// Retrieves the next finished job, if any (returns `false` otherwise). This must only be
+        /// called from the render thread.
+        bool try_pop(LoadResult& result)
+        {
+            return results.try_pop(result);
+        }
+
+        size_t get_number_of_jobs() const
+        {
+            return progress.size();
+        }
+
+        const LoadProgress& get_progress(size_t id) const
+        {
+            return *progress[id];
+        }
+
+    private:
+
+        struct PendingJob
+        {
+            size_t id;
+            Job job;
+            LoadProgress* progress;
+        };
+
+        void run_worker()
+        {
+            while (true)
+            {
+                PendingJob pending;
+                {
+                    std::unique_lock<std::mutex> lock{ mutex };
+                    condition.wait(lock, [this] { return stopping || !jobs.empty(); });
+
+                    if (stopping)
+                    {
+                        return;
+                    }
+                    pending = std::move(jobs.front());
+                    jobs.pop_front();
+                }
+
+                pending.progress->status = LoadStatus::BUILDING;
+
+                std::ostringstream log;
+                log << "Loading " << pending.progress->name << "..." << std::endl;
+
+                try
+                {
+                    auto tetrahedra = std::make_shared<const Tetrahedra>(pending.job([&](float fraction) { pending.progress->fraction = fraction; }, log));
+
+                    pending.progress->fraction = 1.0f;
+                    results.push({ pending.id, TetrahedraView{ *tetrahedra }, tetrahedra });
+                    pending.progress->status = LoadStatus::READY;
+                }
+                catch (const std::exception& e)
+                {
+                    log << "\t" << "Failed: " << e.what() << std::endl;
+                    pending.progress->status = LoadStatus::FAILED;
+                }
+
+                // Write the whole log at once, so that the output of different workers isn't interleaved
+                std::cout << log.str();
+            }
+        }
+
+        /// The progress of every job that has ever been submitted, indexed by job ID (only modified by the render thread)
+        std::vector<std::unique_ptr<LoadProgress>> progress;
+
+        /// Finished jobs, waiting to be picked up by the render thread
+        MpscQueue<LoadResult> results;
+
+        /// Jobs that have not yet been picked up by a worker thread
+        std::deque<PendingJob> jobs;
+        std::mutex mutex;
+        std::condition_variable condition;
+        bool stopping = false;
+
+        std::vector<std::thread> workers;
+    };
+
+}
\ No newline at end of file
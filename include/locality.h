@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <numeric>
+#include <ostream>
+#include <vector>
+
+#include "glm.hpp"
+
+#include "tetrahedra.h"
+
+namespace four
+{
+
+    namespace locality
+    {
+
+        /// The number of entries in the (FIFO) vertex cache that is simulated by `get_cache_metrics(...)`.
+        const size_t cache_size = 32;
+
+        /// Statistics about how well the tetrahedra of a mesh reuse recently referenced vertices.
+        struct CacheMetrics
+        {
+            /// The average number of cache misses per tetrahedron (at most 4: lower is better)
+            float misses_per_tetrahedron = 0.0f;
+
+            /// The average number of cache misses per vertex (ideally, 1)
+            float misses_per_vertex = 0.0f;
+
+            /// The average distance between the smallest and largest vertex index of each tetrahedron
+            float average_index_span = 0.0f;
+        };
+
+        /// Simulates a FIFO vertex cache of `cache_size` entries over the indices of `simplices`.
+        CacheMetrics get_cache_metrics(const std::vector<uint32_t>& simplices, size_t number_of_vertices)
+        {
+            CacheMetrics metrics;
+            if (simplices.empty() || number_of_vertices == 0)
+            {
+                return metrics;
+            }
+
+            std::vector<bool> cached(number_of_vertices, false);
+            std::deque<uint32_t> cache;
+            size_t misses = 0;
+            size_t total_span = 0;
+            for (size_t simplex_index = 0; simplex_index < simplices.size() / 4; ++simplex_index)
+            {
+                uint32_t min_index = std::numeric_limits<uint32_t>::max();
+                uint32_t max_index = 0;
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    const auto index = simplices[simplex_index * 4 + i];
+                    min_index = std::min(min_index, index);
+                    max_index = std::max(max_index, index);
+
+                    if (!cached[index])
+                    {
+                        misses++;
+                        cached[index] = true;
+                        cache.push_back(index);
+                        if (cache.size() > cache_size)
+                        {
+                            cached[cache.front()] = false;
+                            cache.pop_front();
+                        }
+                    }
+                }
+                total_span += max_index - min_index;
+            }
+
+            const size_t number_of_tetrahedra = simplices.size() / 4;
+            metrics.misses_per_tetrahedron = static_cast<float>(misses) / number_of_tetrahedra;
+            metrics.misses_per_vertex = static_cast<float>(misses) / number_of_vertices;
+            metrics.average_index_span = static_cast<float>(total_span) / number_of_tetrahedra;
+
+            return metrics;
+        }
+
+        /// Interleaves the bits of the 4 (16-bit) coordinates into a single 64-bit Morton code.
+        uint64_t interleave(const std::array<uint32_t, 4>& coordinates)
+        {
+            uint64_t code = 0;
+            for (uint32_t bit = 0; bit < 16; ++bit)
+            {
+                for (uint32_t axis = 0; axis < 4; ++axis)
+                {
+                    code |= static_cast<uint64_t>((coordinates[axis] >> bit) & 1) << (bit * 4 + axis);
+                }
+            }
+            return code;
+        }
+
+        /// Returns the Morton code (i.e. position along a Z-order curve) of each of the `points`, after they have been
+        /// quantized to 16 bits per axis within their bounds.
+        std::vector<uint64_t> get_morton_codes(const std::vector<glm::vec4>& points)
+        {
+            glm::vec4 min{ std::numeric_limits<float>::max() };
+            glm::vec4 max{ std::numeric_limits<float>::lowest() };
+            for (const auto& point : points)
+            {
+                min = glm::min(min, point);
+                max = glm::max(max, point);
+            }
+            const glm::vec4 extents = glm::max(max - min, glm::vec4{ std::numeric_limits<float>::epsilon() });
+
+            std::vector<uint64_t> codes;
+            codes.reserve(points.size());
+            for (const auto& point : points)
+            {
+                const glm::vec4 normalized = (point - min) / extents;
+
+                std::array<uint32_t, 4> coordinates;
+                for (int axis = 0; axis < 4; ++axis)
+                {
+                    coordinates[axis] = static_cast<uint32_t>(glm::clamp(normalized[axis], 0.0f, 1.0f) * 65535.0f);
+                }
+                codes.push_back(interleave(coordinates));
+            }
+            return codes;
+        }
+
+        /// Returns the permutation that sorts `codes` (i.e. `order[i]` is the index of the `i`th smallest code).
+        std::vector<uint32_t> get_sorted_order(const std::vector<uint64_t>& codes)
+        {
+            std::vector<uint32_t> order(codes.size());
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return codes[a] < codes[b]; });
+
+            return order;
+        }
+
+        /// Reorders the vertices and tetrahedra of `tetrahedra` (in place) so that nearby elements are stored close together
+        /// in memory, which improves the memory access patterns of the slicing passes and the indexed skeleton draws. The
+        /// vertices are sorted along a 4D Z-order (Morton) curve, and the tetrahedra are sorted along the same curve by their
+        /// centroids, so that consecutive tetrahedra mostly refer to vertices that were referenced recently. All of the index
+        /// arrays are remapped accordingly. The simulated vertex cache metrics before and after are written to `log`.
+        void reorder(Tetrahedra& tetrahedra, std::ostream& log)
+        {
+            const size_t number_of_tetrahedra = tetrahedra.simplices.size() / 4;
+            if (tetrahedra.vertices.empty() || number_of_tetrahedra == 0)
+            {
+                return;
+            }
+
+            const auto before = get_cache_metrics(tetrahedra.simplices, tetrahedra.vertices.size());
+
+            // Sort the vertices along the curve, then remap every array that refers to them by index
+            const auto vertex_order = get_sorted_order(get_morton_codes(tetrahedra.vertices));
+            std::vector<uint32_t> new_vertex_index(vertex_order.size());
+            std::vector<glm::vec4> vertices(vertex_order.size());
+            for (size_t i = 0; i < vertex_order.size(); ++i)
+            {
+                new_vertex_index[vertex_order[i]] = static_cast<uint32_t>(i);
+                vertices[i] = tetrahedra.vertices[vertex_order[i]];
+            }
+            tetrahedra.vertices = std::move(vertices);
+
+            for (auto* indices : { &tetrahedra.simplices, &tetrahedra.edges, &tetrahedra.cell_edges })
+            {
+                for (auto& index : *indices)
+                {
+                    index = new_vertex_index[index];
+                }
+            }
+
+            // Sort the tetrahedra by their centroids, along with everything else that is stored per tetrahedron
+            std::vector<glm::vec4> centroids(number_of_tetrahedra);
+            for (size_t simplex_index = 0; simplex_index < number_of_tetrahedra; ++simplex_index)
+            {
+                glm::vec4 centroid{ 0.0f };
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    centroid += tetrahedra.vertices[tetrahedra.simplices[simplex_index * 4 + i]];
+                }
+                centroids[simplex_index] = centroid * 0.25f;
+            }
+
+            const auto simplex_order = get_sorted_order(get_morton_codes(centroids));
+            std::vector<uint32_t> simplices(tetrahedra.simplices.size());
+            std::vector<glm::vec4> normals;
+            std::vector<uint32_t> cell_indices;
+            for (size_t i = 0; i < simplex_order.size(); ++i)
+            {
+                std::copy_n(tetrahedra.simplices.begin() + simplex_order[i] * 4, 4, simplices.begin() + i * 4);
+
+                if (!tetrahedra.normals.empty())
+                {
+                    normals.push_back(tetrahedra.normals[simplex_order[i]]);
+                }
+                if (!tetrahedra.cell_indices.empty())
+                {
+                    cell_indices.push_back(tetrahedra.cell_indices[simplex_order[i]]);
+                }
+            }
+            tetrahedra.simplices = std::move(simplices);
+            tetrahedra.normals = std::move(normals);
+            tetrahedra.cell_indices = std::move(cell_indices);
+
+            const auto after = get_cache_metrics(tetrahedra.simplices, tetrahedra.vertices.size());
+
+            log << "\t" << "Vertex cache misses per tetrahedron (" << cache_size << " entries): "
+                << before.misses_per_tetrahedron << " -> " << after.misses_per_tetrahedron << std::endl;
+            log << "\t" << "Vertex cache misses per vertex: "
+                << before.misses_per_vertex << " -> " << after.misses_per_vertex << std::endl;
+            log << "\t" << "Average vertex index span per tetrahedron: "
+                << before.average_index_span << " -> " << after.average_index_span << std::endl;
+        }
+
+    }
+
+}
\ No newline at end of file
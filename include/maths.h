@@ -25,8 +25,8 @@ namespace four
 		};
 
         /// 4-dimensional rotations are best thought about as rotations parallel to a plane.
-        /// For any of the six rotations below, only two coordinates change. In the future,
-        /// it might be interesting to explore the 4D equivalent of quaternions: rotors.
+        /// For any of the six rotations below, only two coordinates change. See `rotor.h` for
+        /// the 4D equivalent of quaternions: rotors.
         ///
         /// Reference: `https://math.stackexchange.com/questions/1402362/rotation-in-4d` and `http://hollasch.github.io/ray4/Four-Space_Visualization_of_4D_Objects.html#rotmats`
         glm::mat4 get_simple_rotation_matrix(Plane plane, float angle)
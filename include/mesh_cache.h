@@ -0,0 +1,434 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <optional>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include "glm.hpp"
+
+#include "hull.h"
+#include "permutations.h"
+#include "tetrahedra.h"
+#include "wythoff.h"
+
+namespace four
+{
+
+    namespace cache
+    {
+
+        /// The version of the on-disk mesh format: this must be bumped whenever the layout of the file changes
+        /// *or* whenever the hull / edge-finding code changes in a way that affects its output, so that any
+        /// stale meshes are ignored.
+        const uint32_t format_version = 7;
+
+        /// The directory (relative to the working directory, like the shaders) that cached meshes are written to.
+        const char* const cache_directory = "../cache";
+
+        /// A 64-bit FNV-1a hash, used to build cache keys.
+        ///
+        /// Reference: `http://www.isthe.com/chongo/tech/comp/fnv/`
+        class Hasher
+        {
+
+        public:
+
+            void add_bytes(const void* data, size_t size)
+            {
+                const auto bytes = static_cast<const uint8_t*>(data);
+                for (size_t i = 0; i < size; ++i)
+                {
+                    state ^= bytes[i];
+                    state *= 1099511628211ull;
+                }
+            }
+
+            template<class T>
+            void add(const T& value)
+            {
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be hashed");
+                add_bytes(&value, sizeof(T));
+            }
+
+            void add(const std::string& value)
+            {
+                add(value.size());
+                add_bytes(value.data(), value.size());
+            }
+
+            uint64_t get() const
+            {
+                return state;
+            }
+
+        private:
+
+            uint64_t state = 14695981039346656037ull;
+        };
+
+        /// Starts a key with everything that affects the output of `hull::build_tetrahedra(...)`.
+        Hasher get_base_hasher(bool find_edges)
+        {
+            Hasher hasher;
+            hasher.add(format_version);
+            hasher.add(std::string{ hull::qhull_options });
+            hasher.add(find_edges);
+
+            return hasher;
+        }
+
+        /// Returns the cache key of the polychoron generated from a seed table.
+        uint64_t get_key(const std::vector<combinatorics::PermutationSeed<float>>& seeds, bool find_edges = true)
+        {
+            auto hasher = get_base_hasher(find_edges);
+            hasher.add(seeds.size());
+
+            for (const auto& seed : seeds)
+            {
+                hasher.add(seed.values.size());
+                for (const auto& value : seed.values)
+                {
+                    // Fold -0 onto +0, so that it hashes the same way
+                    hasher.add(value == 0.0f ? 0.0f : value);
+                }
+                hasher.add(seed.with_sign_changes);
+                hasher.add(seed.parity);
+            }
+
+            return hasher.get();
+        }
+
+        /// Returns the cache key of a polychoron from the uniform polychora catalog.
+        uint64_t get_key(const wythoff::CatalogEntry& entry, bool find_edges = true)
+        {
+            auto hasher = get_base_hasher(find_edges);
+            hasher.add(entry.construction);
+            hasher.add(entry.diagram.group);
+            for (bool ring : entry.diagram.rings)
+            {
+                hasher.add(ring);
+            }
+
+            return hasher.get();
+        }
+
+        std::string get_path(uint64_t key)
+        {
+            char name[32];
+            snprintf(name, sizeof(name), "%016llx.tet4", static_cast<unsigned long long>(key));
+
+            return std::string{ cache_directory } + "/" + name;
+        }
+
+        /// A read-only, memory-mapped file.
+        class MappedFile
+        {
+
+        public:
+
+            MappedFile() = default;
+
+            /// Maps the file at `path` into memory, throwing an exception on failure.
+            explicit MappedFile(const std::string& path)
+            {
+#if defined(_WIN32)
+                HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+                if (file == INVALID_HANDLE_VALUE)
+                {
+                    throw std::runtime_error("Could not open file: " + path);
+                }
+
+                LARGE_INTEGER file_size;
+                if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+                {
+                    CloseHandle(file);
+                    throw std::runtime_error("Could not map empty file: " + path);
+                }
+
+                // The view keeps the underlying mapping (and file) alive, so both handles can be closed right away
+                HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+                CloseHandle(file);
+                if (mapping == nullptr)
+                {
+                    throw std::runtime_error("Could not map file: " + path);
+                }
+
+                void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+                CloseHandle(mapping);
+                if (view == nullptr)
+                {
+                    throw std::runtime_error("Could not map file: " + path);
+                }
+
+                pointer = static_cast<const uint8_t*>(view);
+                length = static_cast<size_t>(file_size.QuadPart);
+#else
+                const int descriptor = open(path.c_str(), O_RDONLY);
+                if (descriptor == -1)
+                {
+                    throw std::runtime_error("Could not open file: " + path);
+                }
+
+                struct stat status;
+                if (fstat(descriptor, &status) == -1 || status.st_size == 0)
+                {
+                    close(descriptor);
+                    throw std::runtime_error("Could not map empty file: " + path);
+                }
+
+                // The mapping stays valid after the file descriptor is closed
+                void* view = mmap(nullptr, status.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+                close(descriptor);
+                if (view == MAP_FAILED)
+                {
+                    throw std::runtime_error("Could not map file: " + path);
+                }
+
+                pointer = static_cast<const uint8_t*>(view);
+                length = static_cast<size_t>(status.st_size);
+#endif
+            }
+
+            ~MappedFile()
+            {
+                unmap();
+            }
+
+            MappedFile(const MappedFile&) = delete;
+            MappedFile& operator=(const MappedFile&) = delete;
+
+            MappedFile(MappedFile&& other) noexcept :
+                pointer{ other.pointer },
+                length{ other.length }
+            {
+                other.pointer = nullptr;
+                other.length = 0;
+            }
+
+            MappedFile& operator=(MappedFile&& other) noexcept
+            {
+                if (this != &other)
+                {
+                    unmap();
+                    pointer = other.pointer;
+                    length = other.length;
+                    other.pointer = nullptr;
+                    other.length = 0;
+                }
+                return *this;
+            }
+
+            const uint8_t* data() const
+            {
+                return pointer;
+            }
+
+            size_t size() const
+            {
+                return length;
+            }
+
+        private:
+
+            void unmap()
+            {
+                if (pointer != nullptr)
+                {
+#if defined(_WIN32)
+                    UnmapViewOfFile(pointer);
+#else
+                    munmap(const_cast<uint8_t*>(pointer), length);
+#endif
+                    pointer = nullptr;
+                    length = 0;
+                }
+            }
+
+            const uint8_t* pointer = nullptr;
+            size_t length = 0;
+        };
+
+        /// Calls `f(array)` for each of the arrays that make up `tetrahedra` (either a `Tetrahedra` or a `TetrahedraView`),
+        /// in the order that they are stored on disk.
+        template<class T, class F>
+        void for_each_array(T& tetrahedra, F f)
+        {
+            f(tetrahedra.vertices);
+            f(tetrahedra.simplices);
+            f(tetrahedra.edges);
+            f(tetrahedra.normals);
+            f(tetrahedra.cell_indices);
+            f(tetrahedra.cell_offsets);
+            f(tetrahedra.cell_edges);
+            f(tetrahedra.cell_face_offsets);
+        }
+
+        const size_t number_of_arrays = 8;
+
+        /// The header at the start of every cached mesh. It is followed by each of the arrays listed in `for_each_array(...)`
+        /// (in that order), each of which starts at a 16-byte aligned offset. All values are stored in the native byte
+        /// order, since the cache is never shared between machines.
+        struct FileHeader
+        {
+            char magic[4];
+            uint32_t version;
+            uint64_t key;
+
+            // The number of elements in (and byte offset of) each of the arrays
+            uint64_t counts[number_of_arrays];
+            uint64_t offsets[number_of_arrays];
+        };
+
+        const char magic[4] = { 'T', 'E', 'T', '4' };
+
+        /// A set of tetrahedra whose arrays point directly into a memory-mapped cache file: `view` is only valid for
+        /// as long as `file` is alive.
+        struct CachedTetrahedra
+        {
+            MappedFile file;
+            TetrahedraView view;
+        };
+
+        /// Attempts to map the cached mesh with the given `key`. An empty optional is returned if there is no such mesh
+        /// or if the file is stale or malformed (in which case, it will simply be overwritten by the next `save(...)`).
+        std::optional<CachedTetrahedra> load(uint64_t key)
+        {
+            const auto path = get_path(key);
+            std::error_code error;
+            if (!std::filesystem::exists(path, error))
+            {
+                return std::nullopt;
+            }
+
+            CachedTetrahedra cached;
+            try
+            {
+                cached.file = MappedFile{ path };
+            }
+            catch (const std::exception&)
+            {
+                return std::nullopt;
+            }
+
+            if (cached.file.size() < sizeof(FileHeader))
+            {
+                return std::nullopt;
+            }
+
+            FileHeader header;
+            std::memcpy(&header, cached.file.data(), sizeof(FileHeader));
+            if (std::memcmp(header.magic, magic, sizeof(magic)) != 0 || header.version != format_version || header.key != key)
+            {
+                return std::nullopt;
+            }
+
+            bool valid = true;
+            size_t i = 0;
+            for_each_array(cached.view, [&](auto& span)
+            {
+                using T = typename std::decay_t<decltype(span)>::value_type;
+
+                if (header.offsets[i] % 16 != 0 ||
+                    header.offsets[i] > cached.file.size() ||
+                    header.counts[i] > (cached.file.size() - header.offsets[i]) / sizeof(T))
+                {
+                    valid = false;
+                }
+                else
+                {
+                    span = { reinterpret_cast<const T*>(cached.file.data() + header.offsets[i]), header.counts[i] };
+                }
+                i++;
+            });
+
+            if (!valid)
+            {
+                return std::nullopt;
+            }
+
+            return cached;
+        }
+
+        /// Writes `tetrahedra` to the cache under the given `key`. The file is written to a temporary location first and
+        /// then renamed, so that concurrent (or interrupted) writes never leave a partial mesh behind. Throws an
+        /// exception on failure.
+        void save(uint64_t key, const Tetrahedra& tetrahedra)
+        {
+            std::filesystem::create_directories(cache_directory);
+
+            const auto align = [](uint64_t offset) { return (offset + 15) & ~uint64_t{ 15 }; };
+
+            FileHeader header;
+            std::memcpy(header.magic, magic, sizeof(magic));
+            header.version = format_version;
+            header.key = key;
+            const void* arrays[number_of_arrays];
+            size_t sizes[number_of_arrays];
+            uint64_t offset = align(sizeof(FileHeader));
+
+            size_t i = 0;
+            for_each_array(tetrahedra, [&](const auto& array)
+            {
+                arrays[i] = array.data();
+                sizes[i] = array.size() * sizeof(array[0]);
+                header.counts[i] = array.size();
+                header.offsets[i] = offset;
+                offset = align(offset + sizes[i]);
+                i++;
+            });
+
+            const auto path = get_path(key);
+            // Every write gets its own temporary file, in case the same mesh is being built by two workers at once
+            static std::atomic<uint32_t> number_of_writes{ 0 };
+            const auto temporary_path = path + "." + std::to_string(number_of_writes++) + ".tmp";
+            {
+                std::ofstream file{ temporary_path, std::ios::binary | std::ios::trunc };
+                if (!file)
+                {
+                    throw std::runtime_error("Could not open file for writing: " + temporary_path);
+                }
+
+                const char padding[16] = {};
+                file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+                file.write(padding, header.offsets[0] - sizeof(FileHeader));
+                for (size_t i = 0; i < number_of_arrays; ++i)
+                {
+                    file.write(static_cast<const char*>(arrays[i]), sizes[i]);
+                    file.write(padding, align(sizes[i]) - sizes[i]);
+                }
+
+                if (!file)
+                {
+                    throw std::runtime_error("Could not write file: " + temporary_path);
+                }
+            }
+
+            std::filesystem::rename(temporary_path, path);
+        }
+
+    }
+
+}
\ No newline at end of file
@@ -1,10 +1,15 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <cstring>
 #include <iostream>
-#include <set>
+#include <limits>
+#include <stdexcept>
 #include <vector>
 
+#include "glm.hpp"
+
 #include "epermute.h"
 
 namespace four
@@ -131,53 +136,221 @@ namespace four
 			Parity parity;
 		};
 
-		template<class T>
-		std::set<std::vector<T>> generate(const std::vector<PermutationSeed<T>>& permutation_seeds)
+		/// A single permutation of 4 elements (an element of the symmetric group S4), stored
+		/// as a list of source indices together with its parity.
+		struct Permutation4
+		{
+			std::array<uint8_t, 4> indices;
+			bool odd;
+		};
+
+		/// Returns a table of all 24 permutations of 4 elements in lexicographic order. The
+		/// parity of each permutation is found by counting its inversions.
+		const std::array<Permutation4, 24>& get_permutation_table()
+		{
+			static const std::array<Permutation4, 24> table = []()
+			{
+				std::array<Permutation4, 24> permutations;
+				std::array<uint8_t, 4> indices = { 0, 1, 2, 3 };
+
+				size_t i = 0;
+				do
+				{
+					size_t inversions = 0;
+					for (size_t a = 0; a < 4; ++a)
+					{
+						for (size_t b = a + 1; b < 4; ++b)
+						{
+							if (indices[a] > indices[b])
+							{
+								inversions++;
+							}
+						}
+					}
+					permutations[i++] = Permutation4{ indices, inversions % 2 == 1 };
+				} while (std::next_permutation(indices.begin(), indices.end()));
+
+				return permutations;
+			}();
+
+			return table;
+		}
+
+		/// An open-addressing hash set of 4-dimensional points. Unique points are written
+		/// straight into a flat array (in insertion order), while the table itself only
+		/// stores indices into that array. Points are compared bitwise, after folding
+		/// negative zero onto positive zero.
+		class PointSet
 		{
-			std::set<std::vector<T>> output_permutations;
 
+		public:
+
+			explicit PointSet(size_t expected_count = 64)
+			{
+				size_t capacity = 64;
+				while (capacity < expected_count * 2)
+				{
+					capacity *= 2;
+				}
+				slots.assign(capacity, empty);
+				points.reserve(expected_count);
+			}
+
+			/// Inserts `point` into the set, returning `true` if it was not already present.
+			bool insert(glm::vec4 point)
+			{
+				// Adding zero turns -0.0 into +0.0, so that both hash (and compare) equally
+				point += glm::vec4{ 0.0f };
+
+				if ((points.size() + 1) * 2 > slots.size())
+				{
+					grow();
+				}
+
+				const size_t mask = slots.size() - 1;
+				for (size_t slot = hash(point) & mask; ; slot = (slot + 1) & mask)
+				{
+					if (slots[slot] == empty)
+					{
+						slots[slot] = static_cast<uint32_t>(points.size());
+						points.push_back(point);
+						return true;
+					}
+					if (points[slots[slot]] == point)
+					{
+						return false;
+					}
+				}
+			}
+
+			size_t size() const
+			{
+				return points.size();
+			}
+
+			/// All of the unique points that have been inserted so far
+			std::vector<glm::vec4> points;
+
+		private:
+
+			static constexpr uint32_t empty = std::numeric_limits<uint32_t>::max();
+
+			static size_t hash(const glm::vec4& point)
+			{
+				uint64_t h = 0x9e3779b97f4a7c15ull;
+				for (size_t i = 0; i < 4; ++i)
+				{
+					uint32_t bits;
+					std::memcpy(&bits, &point[i], sizeof(bits));
+
+					// A round of the "splitmix64" finalizer per component
+					h ^= bits;
+					h *= 0xbf58476d1ce4e5b9ull;
+					h ^= h >> 31;
+				}
+				return static_cast<size_t>(h);
+			}
+
+			void grow()
+			{
+				slots.assign(slots.size() * 2, empty);
+
+				const size_t mask = slots.size() - 1;
+				for (uint32_t index = 0; index < points.size(); ++index)
+				{
+					size_t slot = hash(points[index]) & mask;
+					while (slots[slot] != empty)
+					{
+						slot = (slot + 1) & mask;
+					}
+					slots[slot] = index;
+				}
+			}
+
+			std::vector<uint32_t> slots;
+		};
+
+		/// Generates all of the (unique) 4-dimensional points described by `permutation_seeds`.
+		/// Each seed is expanded by applying every permutation of the requested parity from the
+		/// precomputed S4 table and, optionally, every change-of-sign (enumerated as a 4-bit
+		/// mask). As with `find_all_permutations(...)`, parity is measured relative to the
+		/// seed's values in sorted order.
+		///
+		/// The resulting points are returned in lexicographic order, so that downstream consumers
+		/// (i.e. QHull) always see the points in the same order regardless of how they were found.
+		std::vector<glm::vec4> generate(const std::vector<PermutationSeed<float>>& permutation_seeds)
+		{
+			const auto& permutation_table = get_permutation_table();
+
+			size_t expected_count = 0;
 			for (const auto& seed : permutation_seeds)
 			{
-				std::set<std::vector<T>> inputs;
-				inputs.insert(seed.values);
+				expected_count += permutation_table.size() * (seed.with_sign_changes ? 16 : 1);
+			}
+
+			PointSet output_permutations{ expected_count };
 
-				for (const auto& input : inputs)
+			for (const auto& seed : permutation_seeds)
+			{
+				if (seed.values.size() != 4)
 				{
-					// Calculate permutations for this subset of the inputs and update the output set
-					auto current_permutations = find_all_permutations(input, seed.parity);
-					for (const auto& permutation : current_permutations)
+					throw std::runtime_error("Permutation seed does not have the correct number of dimensions");
+				}
+
+				std::array<float, 4> sorted = { seed.values[0], seed.values[1], seed.values[2], seed.values[3] };
+				std::sort(sorted.begin(), sorted.end());
+
+				for (const auto& permutation : permutation_table)
+				{
+					if ((seed.parity == Parity::EVEN && permutation.odd) ||
+						(seed.parity == Parity::ODD && !permutation.odd))
 					{
-						output_permutations.insert(permutation);
+						continue;
+					}
 
-						// Do we also need to try all sign changes?
-						if (seed.with_sign_changes)
-						{
-							// Generate a list of indices, i.e. 0, 1, 2, ..., values.size() - we will use these to 
-							// "flip" the sign of a (sub)set of the elements below
-							std::vector<size_t> indices(seed.values.size());
-							size_t counter = 0;
-							std::generate(indices.begin(), indices.end(), [&] { return counter++; });
+					const glm::vec4 permuted = {
+						sorted[permutation.indices[0]],
+						sorted[permutation.indices[1]],
+						sorted[permutation.indices[2]],
+						sorted[permutation.indices[3]]
+					};
 
-							// Generate the powerset of the indices generated above - in other words, a set of all of the 
-							// unique subsets (pairings) of the elements in the original list
-							auto sign_changes = powerset(indices);
+					// There is no point flipping the sign of a zero, so only consider sign changes
+					// of the non-zero elements
+					uint32_t non_zero_mask = 0;
+					for (size_t i = 0; i < 4; ++i)
+					{
+						if (permuted[i] != 0.0f)
+						{
+							non_zero_mask |= 1u << i;
+						}
+					}
+					const uint32_t sign_change_masks = seed.with_sign_changes ? 16 : 1;
 
-							for (const auto& sign_change : sign_changes)
-							{
-								// Make a copy of the original seed values and negate all of the relevant indices
-								auto current_values = permutation;
-								for (size_t index : sign_change)
-								{
-									current_values[index] *= -1;
-								}
-								output_permutations.insert(current_values);
-							}
+					for (uint32_t sign_change = 0; sign_change < sign_change_masks; ++sign_change)
+					{
+						if ((sign_change & ~non_zero_mask) != 0)
+						{
+							continue;
 						}
+
+						output_permutations.insert({
+							(sign_change & 1u) ? -permuted[0] : permuted[0],
+							(sign_change & 2u) ? -permuted[1] : permuted[1],
+							(sign_change & 4u) ? -permuted[2] : permuted[2],
+							(sign_change & 8u) ? -permuted[3] : permuted[3]
+						});
 					}
 				}
 			}
 
-			return output_permutations;
+			auto points = std::move(output_permutations.points);
+			std::sort(points.begin(), points.end(), [](const glm::vec4& a, const glm::vec4& b)
+			{
+				return std::lexicographical_compare(&a[0], &a[0] + 4, &b[0], &b[0] + 4);
+			});
+
+			return points;
 		}
 	}
 
@@ -1,5 +1,7 @@
 #pragma once
 
+#include <string>
+
 #include "hyperplane.h"
 #include "permutations.h"
 
@@ -220,6 +222,23 @@ namespace four
         };
     }
 
+    /// Returns the names of the polychora generated by `get_all_permutation_seeds()` (in the same order).
+    std::vector<std::string> get_all_permutation_seed_names()
+    {
+        return {
+            "8-cell",
+            "16-cell",
+            "24-cell",
+            "120-cell",
+            "600-cell",
+            "Bitruncated 8-cell",
+            "Cantellated 24-cell",
+            "Bitruncated 120-cell",
+            "Omnitruncated 120-cell",
+            "Cantellated 120-cell"
+        };
+    }
+
     /// A struct that describes a regular polychoron (4-polytope).
     ///
     /// See: https://en.wikipedia.org/wiki/4-polytope
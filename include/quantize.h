@@ -0,0 +1,152 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "glm.hpp"
+
+#include "tetrahedra.h"
+
+namespace four
+{
+
+    namespace quantize
+    {
+
+        /// Converts `value` (which is clamped to [-1, 1]) to a signed, normalized integer with `bits` bits, i.e. the inverse of
+        /// `from_snorm(...)`. This matches GLSL's `packSnorm*` functions.
+        int32_t to_snorm(float value, uint32_t bits)
+        {
+            const float scale = static_cast<float>((1 << (bits - 1)) - 1);
+            return static_cast<int32_t>(std::round(glm::clamp(value, -1.0f, 1.0f) * scale));
+        }
+
+        /// Converts a signed, normalized integer with `bits` bits back to a float in [-1, 1]. This matches GLSL's `unpackSnorm*`
+        /// functions (and normalized integer vertex attributes).
+        float from_snorm(int32_t value, uint32_t bits)
+        {
+            const float scale = static_cast<float>((1 << (bits - 1)) - 1);
+            return std::max(static_cast<float>(value) / scale, -1.0f);
+        }
+
+        /// Packs 2 floats into a single `uint` as 16-bit snorms, with `a` in the least significant bits (like `packSnorm2x16`).
+        uint32_t pack_snorm_2x16(float a, float b)
+        {
+            return (static_cast<uint32_t>(to_snorm(a, 16)) & 0xFFFF) |
+                   ((static_cast<uint32_t>(to_snorm(b, 16)) & 0xFFFF) << 16);
+        }
+
+        /// Packs 4 floats into a single `uint` as 8-bit snorms, with `x` in the least significant bits (like `packSnorm4x8`).
+        uint32_t pack_snorm_4x8(const glm::vec4& value)
+        {
+            uint32_t packed = 0;
+            for (int i = 0; i < 4; ++i)
+            {
+                packed |= (static_cast<uint32_t>(to_snorm(value[i], 8)) & 0xFF) << (i * 8);
+            }
+            return packed;
+        }
+
+        /// Rounds `value` to the nearest (finite) half-precision float, i.e. the result of a round trip through `packHalf2x16`.
+        float to_half_precision(float value)
+        {
+            // Below the smallest normal half (2^-14), the spacing between halves is a constant 2^-24
+            if (std::abs(value) < std::ldexp(1.0f, -14))
+            {
+                return std::ldexp(std::round(std::ldexp(value, 24)), -24);
+            }
+
+            // Otherwise, there are 11 significant bits (including the implicit one)
+            int exponent;
+            const float mantissa = std::frexp(value, &exponent);
+            return std::ldexp(std::round(std::ldexp(mantissa, 11)), exponent - 11);
+        }
+
+        /// Encodes each of the `positions` as 4 16-bit snorms (2 `uint`s). This is only exact (up to rounding) if all of their
+        /// coordinates lie in [-1, 1] (i.e. for polychora that are normalized to unit radius): any other coordinates are
+        /// clamped, which shows up as a large `PrecisionReport::max_position_error`.
+        std::vector<uint32_t> encode_positions(Span<glm::vec4> positions)
+        {
+            std::vector<uint32_t> encoded;
+            encoded.reserve(positions.size() * 2);
+            for (const auto& position : positions)
+            {
+                encoded.push_back(pack_snorm_2x16(position.x, position.y));
+                encoded.push_back(pack_snorm_2x16(position.z, position.w));
+            }
+            return encoded;
+        }
+
+        /// Encodes each of the (unit) `normals` as 4 8-bit snorms (a single `uint`).
+        std::vector<uint32_t> encode_normals(Span<glm::vec4> normals)
+        {
+            std::vector<uint32_t> encoded;
+            encoded.reserve(normals.size());
+            for (const auto& normal : normals)
+            {
+                encoded.push_back(pack_snorm_4x8(normal));
+            }
+            return encoded;
+        }
+
+        /// How far the compact formats are from the full-precision ones, for a single mesh.
+        struct PrecisionReport
+        {
+            /// The largest and root-mean-square distance (in 4-space) between each vertex and its 16-bit snorm encoding
+            float max_position_error = 0.0f;
+            float rms_position_error = 0.0f;
+
+            /// The largest distance between each vertex and its half-precision encoding (i.e. the error of a slice vertex
+            /// at the same position, ignoring the error that is carried over from the vertex itself)
+            float max_slice_vertex_error = 0.0f;
+
+            /// The largest angle (in degrees) between each tetrahedron's normal and its 8-bit snorm encoding
+            float max_normal_error = 0.0f;
+        };
+
+        /// Measures the error of the compact formats (against the full-precision formats) for the mesh in `tetrahedra`.
+        PrecisionReport get_precision_report(const TetrahedraView& tetrahedra)
+        {
+            PrecisionReport report;
+
+            double sum_of_squares = 0.0;
+            for (const auto& position : tetrahedra.vertices)
+            {
+                glm::vec4 snorm;
+                glm::vec4 half;
+                for (int i = 0; i < 4; ++i)
+                {
+                    snorm[i] = from_snorm(to_snorm(position[i], 16), 16);
+                    half[i] = to_half_precision(position[i]);
+                }
+
+                const float error = glm::distance(position, snorm);
+                report.max_position_error = std::max(report.max_position_error, error);
+                report.max_slice_vertex_error = std::max(report.max_slice_vertex_error, glm::distance(position, half));
+                sum_of_squares += error * error;
+            }
+            if (!tetrahedra.vertices.empty())
+            {
+                report.rms_position_error = static_cast<float>(std::sqrt(sum_of_squares / tetrahedra.vertices.size()));
+            }
+
+            for (const auto& normal : tetrahedra.normals)
+            {
+                glm::vec4 decoded;
+                for (int i = 0; i < 4; ++i)
+                {
+                    decoded[i] = from_snorm(to_snorm(normal[i], 8), 8);
+                }
+
+                const float cosine = glm::dot(glm::normalize(normal), glm::normalize(decoded));
+                report.max_normal_error = std::max(report.max_normal_error, glm::degrees(std::acos(glm::clamp(cosine, -1.0f, 1.0f))));
+            }
+
+            return report;
+        }
+
+    }
+
+}
\ No newline at end of file
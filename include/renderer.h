@@ -1,225 +1,528 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "glm.hpp"
 
+#include "bvh.h"
 #include "hyperplane.h"
+#include "quantize.h"
+#include "rotor.h"
 #include "shader.h"
+#include "simd.h"
+#include "tetrahedra.h"
 
 namespace four
 {
 
-    struct Tetrahedra
-    {
-        // All of the tetrahedra vertices as a single, flat array (4 vertices per tetrahedra)
-        std::vector<glm::vec4> vertices;
-
-        // All of the simplex indices (4 indices per tetrahedra)
-        std::vector<uint32_t> simplices;
-
-        std::vector<uint32_t> edges;
-
-        // All of the hyperplane normals corresponding to each tetrahedron (from convex hull)
-        std::vector<glm::vec4> normals;
-    };
-    
-    std::array<std::pair<uint32_t, uint32_t>, 6> get_edge_indices()
-    {
-        return { {
-            { 0, 1 },
-            { 0, 2 },
-            { 0, 3 },
-            { 1, 2 },
-            { 1, 3 },
-            { 2, 3 }
-        } };
-    }
-
 	class Renderer
 	{
 
 	public:
 
-        Renderer() :
-            compute{ graphics::Shader{ "../shaders/compute_slice.glsl" } }
-        {}
+        /// The maximum number of vertices in the polygon that results from slicing a single cell: this must match
+        /// `MAX_POLYGON_VERTICES` in `compute_slice_cells.glsl`
+        static const size_t max_polygon_vertices = 64;
 
-        void add_tetrahedra(const Tetrahedra& tetrahedra, const glm::mat4& transform = glm::mat4{ 1.0f })
+        /// The layout of the (static) vertex positions and tetrahedron normals, and of the slice vertices: either full `vec4`
+        /// floats, or a compact layout where vertex positions are 4 16-bit snorms (which requires every polychoron to be
+        /// normalized to unit radius), normals are 4 8-bit snorms, and slice vertices are 4 half floats.
+        enum class VertexFormat
         {
-            Batch batch;
+            FLOAT32,
+            COMPACT
+        };
 
-            std::vector<glm::vec4> tetrahedra_vertices;
-            std::vector<glm::vec4> tetrahedra_colors;
-            batch.number_of_tetrahedra = tetrahedra.simplices.size() / 4;
-            batch.number_of_edges = tetrahedra.edges.size() / 2;
+        explicit Renderer(VertexFormat vertex_format = VertexFormat::FLOAT32) :
+            compute_transform{ graphics::Shader{ "../shaders/compute_transform.glsl" } },
+            compute_clusters{ graphics::Shader{ "../shaders/compute_cull_clusters.glsl" } },
+            compute_edges{ graphics::Shader{ "../shaders/compute_slice_edges.glsl" } },
+            compute{ graphics::Shader{ "../shaders/compute_slice.glsl" } },
+            compute_cells{ graphics::Shader{ "../shaders/compute_slice_cells.glsl" } },
+            vertex_format{ vertex_format }
+        {
+            glCreateVertexArrays(1, &vao_slice);
+            glCreateVertexArrays(1, &vao_slice_cells);
+            glCreateVertexArrays(1, &vao_skeleton);
 
-            // Any tetrahedral slice can have at most 6 vertices (a quadrilateral, 2 triangles)
-            const size_t max_vertices_per_slice = 6;
-            const size_t number_of_vertices_per_tetrahedron = 4;
+            // Set up attribute #0 (positions) of each VAO: the actual vertex buffers are attached whenever they are
+            // (re)allocated, see `attach_buffers()`
+            for (const auto vao : { vao_slice, vao_slice_cells, vao_skeleton })
+            {
+                glEnableVertexArrayAttrib(vao, 0);
+                glVertexArrayAttribFormat(vao, 0, 4, GL_FLOAT, GL_FALSE, 0);
+                glVertexArrayAttribBinding(vao, 0, 0);
+            }
 
-            for (size_t simplex_index = 0; simplex_index < tetrahedra.simplices.size() / 4; ++simplex_index)
+            // Compact vertices are decoded by the vertex fetch itself, so `projections.vert` always sees a `vec4`
+            if (vertex_format == VertexFormat::COMPACT)
             {
-                tetrahedra_vertices.push_back(tetrahedra.vertices[tetrahedra.simplices[simplex_index * 4 + 0]]);
-                tetrahedra_vertices.push_back(tetrahedra.vertices[tetrahedra.simplices[simplex_index * 4 + 1]]);
-                tetrahedra_vertices.push_back(tetrahedra.vertices[tetrahedra.simplices[simplex_index * 4 + 2]]);
-                tetrahedra_vertices.push_back(tetrahedra.vertices[tetrahedra.simplices[simplex_index * 4 + 3]]);
+                glVertexArrayAttribFormat(vao_slice, 0, 4, GL_HALF_FLOAT, GL_FALSE, 0);
+                glVertexArrayAttribFormat(vao_skeleton, 0, 4, GL_SHORT, GL_TRUE, 0);
+            }
+
+            // The cluster culling pass fills in this command, which determines how many tetrahedra are sliced
+            cluster_dispatch.resize(sizeof(DispatchCommand));
+        }
 
-                // Next, push back all of this tetrahedron's colors (currently, we are
-                // using the cell centroid to generate some sort of shading / colors)
-                for (size_t i = 0; i < max_vertices_per_slice; ++i)
+        /// Appends a new mesh to the scene, along with a single object (i.e. instance) of it: all of the mesh's data is packed
+        /// into the end of the renderer's shared buffers (so that the whole scene can be sliced with a single dispatch per pass).
+        /// Returns the index of the new object.
+        size_t add_tetrahedra(const TetrahedraView& tetrahedra, const glm::mat4& transform = glm::mat4{ 1.0f })
+        {
+            Mesh mesh;
+
+            mesh.first_vertex = vertices.size / get_vertex_size();
+            mesh.number_of_vertices = tetrahedra.vertices.size();
+            mesh.first_tetrahedron = simplices.size / (sizeof(uint32_t) * 4);
+            mesh.number_of_tetrahedra = tetrahedra.simplices.size() / 4;
+            mesh.first_cluster = clusters.size / sizeof(Cluster);
+            mesh.first_slice_edge = slice_edges.size / (sizeof(uint32_t) * 2);
+            mesh.first_edge = edges.size / (sizeof(uint32_t) * 2);
+            mesh.number_of_edges = tetrahedra.edges.size() / 2;
+
+            // QHull returns the tetrahedra in an arbitrary order, so group them into clusters first: each cluster is (part of)
+            // a single cell, so that its tetrahedra are close together and can be culled all at once
+            std::vector<uint32_t> simplices_data;
+            std::vector<glm::vec4> normals_data;
+            build_clusters(tetrahedra, mesh, simplices_data, normals_data);
+
+            // Reorder the vertices of each tetrahedron (if necessary) so that it is positively oriented with respect to its
+            // (outward-facing) hull normal, i.e. det(b - a, c - a, d - a, n) > 0: together with the case table in
+            // `compute_slice.glsl`, this guarantees that every slice triangle faces outwards
+            for (size_t simplex_index = 0; simplex_index < mesh.number_of_tetrahedra; ++simplex_index)
+            {
+                const auto& a = tetrahedra.vertices[simplices_data[simplex_index * 4 + 0]];
+                const auto& b = tetrahedra.vertices[simplices_data[simplex_index * 4 + 1]];
+                const auto& c = tetrahedra.vertices[simplices_data[simplex_index * 4 + 2]];
+                const auto& d = tetrahedra.vertices[simplices_data[simplex_index * 4 + 3]];
+
+                if (glm::determinant(glm::mat4{ b - a, c - a, d - a, normals_data[simplex_index] }) < 0.0f)
                 {
-                    tetrahedra_colors.push_back(tetrahedra.normals[simplex_index]);
+                    std::swap(simplices_data[simplex_index * 4 + 2], simplices_data[simplex_index * 4 + 3]);
                 }
             }
 
+            // Find the unique edges of the tetrahedral mesh (most of which are shared by several tetrahedra), along with
+            // the 6 edges of each tetrahedron (see `compute_slice.glsl` for the order)
+            std::vector<uint32_t> slice_edges_data;
+            std::vector<uint32_t> tetrahedra_edges_data;
+            std::unordered_map<uint64_t, uint32_t> vertices_to_edge;
+            tetrahedra_edges_data.reserve(mesh.number_of_tetrahedra * 6);
+
+            for (size_t simplex_index = 0; simplex_index < mesh.number_of_tetrahedra; ++simplex_index)
             {
-                glCreateVertexArrays(1, &batch.vao_slice);
+                for (const auto& [i, j] : tetrahedron_edges)
+                {
+                    auto a = simplices_data[simplex_index * 4 + i];
+                    auto b = simplices_data[simplex_index * 4 + j];
+                    const uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+
+                    auto [iter, inserted] = vertices_to_edge.insert({ key, static_cast<uint32_t>(slice_edges_data.size() / 2) });
+                    if (inserted)
+                    {
+                        slice_edges_data.push_back(a);
+                        slice_edges_data.push_back(b);
+                    }
+                    tetrahedra_edges_data.push_back(iter->second);
+                }
+            }
+            mesh.number_of_slice_edges = slice_edges_data.size() / 2;
+
+            // Note that all of the indices are local to this mesh (i.e. vertex index 0 is this mesh's first vertex), since
+            // each instance of it transforms its own copy of the vertices
+            if (vertex_format == VertexFormat::COMPACT)
+            {
+                const auto vertices_data = quantize::encode_positions(tetrahedra.vertices);
+                vertices.append(vertices_data.data(), vertices_data.size() * sizeof(uint32_t));
+            }
+            else
+            {
+                vertices.append(tetrahedra.vertices.data(), tetrahedra.vertices.size() * sizeof(glm::vec4));
+            }
+            simplices.append(simplices_data.data(), simplices_data.size() * sizeof(uint32_t));
+            tetrahedra_edges.append(tetrahedra_edges_data.data(), tetrahedra_edges_data.size() * sizeof(uint32_t));
+            slice_edges.append(slice_edges_data.data(), slice_edges_data.size() * sizeof(uint32_t));
+            edges.append(tetrahedra.edges.data(), tetrahedra.edges.size() * sizeof(uint32_t));
 
-                // Set up attribute #0: positions
-                const uint32_t attrib_pos = 0;
-                const uint32_t binding_pos = 0;
-                glEnableVertexArrayAttrib(batch.vao_slice, attrib_pos);
-                glVertexArrayAttribFormat(batch.vao_slice, attrib_pos, 4, GL_FLOAT, GL_FALSE, 0);
-                glVertexArrayAttribBinding(batch.vao_slice, attrib_pos, binding_pos);
+            // The per-tetrahedron colors (currently, we are using the hyperplane normal to generate some sort of shading / colors)
+            if (vertex_format == VertexFormat::COMPACT)
+            {
+                const auto encoded_normals = quantize::encode_normals(normals_data);
+                tetrahedra_normals.append(encoded_normals.data(), encoded_normals.size() * sizeof(uint32_t));
 
-                // Set up attribute #1: colors
-                const uint32_t atrrib_col = 1;
-                const uint32_t binding_col = 1;
-                glEnableVertexArrayAttrib(batch.vao_slice, atrrib_col);
-                glVertexArrayAttribFormat(batch.vao_slice, atrrib_col, 4, GL_FLOAT, GL_FALSE, 0);
-                glVertexArrayAttribBinding(batch.vao_slice, atrrib_col, binding_col);
+                mesh.precision_report = quantize::get_precision_report(tetrahedra);
+            }
+            else
+            {
+                tetrahedra_normals.append(normals_data.data(), normals_data.size() * sizeof(glm::vec4));
+            }
+            clusters.append(mesh.clusters.data(), mesh.clusters.size() * sizeof(Cluster));
 
-                auto vertices_size = sizeof(glm::vec4) * number_of_vertices_per_tetrahedron * batch.number_of_tetrahedra;
-                auto colors_size = sizeof(glm::vec4) * max_vertices_per_slice * batch.number_of_tetrahedra;
+            // Set up the (optional) pipeline that slices whole cells rather than tetrahedra
+            mesh.first_cell = cell_ranges.size / sizeof(glm::uvec2);
 
-                // The VBO that will be associated with the vertex attribute #1, which does not change
-                // throughout the lifetime of the program (thus, we use the flag `STATIC_DRAW` below)
-                glCreateBuffers(1, &batch.buffer_slice_hyperplane_normals);
-                glNamedBufferData(batch.buffer_slice_hyperplane_normals, colors_size, tetrahedra_colors.data(), GL_STATIC_DRAW);
+            const auto faces_per_cell = get_faces_per_cell(tetrahedra);
+            if (!faces_per_cell.empty() && *std::max_element(faces_per_cell.begin(), faces_per_cell.end()) <= max_polygon_vertices)
+            {
+                mesh.number_of_cells = tetrahedra.cell_offsets.size() - 1;
 
-                // The buffer that will be bound at index #0 and read from
-                glCreateBuffers(1, &batch.buffer_tetrahedra);
-                glNamedBufferData(batch.buffer_tetrahedra, vertices_size, tetrahedra_vertices.data(), GL_STATIC_DRAW);
+                // A cell with F faces is sliced into a polygon with (at most) F vertices, i.e. F - 2 triangles
+                for (const auto faces : faces_per_cell)
+                {
+                    mesh.max_cell_slice_vertices += (faces - 2) * 3;
+                }
 
-                // The buffer of slice vertices that will be written to whenever the slicing hyperplane moves
-                auto alloc_size = sizeof(glm::vec4) * max_vertices_per_slice * batch.number_of_tetrahedra;
-                glCreateBuffers(1, &batch.buffer_slice_vertices);
-                glNamedBufferData(batch.buffer_slice_vertices, alloc_size, nullptr, GL_STREAM_DRAW);
+                // Each cell's slice is oriented using the hyperplane normal of (any) one of its tetrahedra...
+                std::vector<glm::vec4> cell_normals_data(mesh.number_of_cells);
+                for (size_t simplex_index = 0; simplex_index < tetrahedra.cell_indices.size(); ++simplex_index)
+                {
+                    cell_normals_data[tetrahedra.cell_indices[simplex_index]] = tetrahedra.normals[simplex_index];
+                }
 
-                // The buffer of draw commands that will be filled out by the compute shader dispatch
-                alloc_size = sizeof(DrawCommand) * batch.number_of_tetrahedra;
-                glCreateBuffers(1, &batch.buffer_indirect_commands);
-                glNamedBufferData(batch.buffer_indirect_commands, alloc_size, nullptr, GL_STREAM_DRAW);
+                // ...and its slice is colored like its first tetrahedron (see `projections.frag`): since the clusters are
+                // sorted by cell (see `build_clusters(...)`), that is the number of tetrahedra in all of the preceding cells
+                std::vector<uint32_t> cell_tetrahedra_data(mesh.number_of_cells, 0);
+                for (const auto cell : tetrahedra.cell_indices)
+                {
+                    if (cell + 1 < mesh.number_of_cells)
+                    {
+                        cell_tetrahedra_data[cell + 1]++;
+                    }
+                }
+                std::partial_sum(cell_tetrahedra_data.begin(), cell_tetrahedra_data.end(), cell_tetrahedra_data.begin());
+                for (auto& simplex_index : cell_tetrahedra_data)
+                {
+                    simplex_index += mesh.first_tetrahedron;
+                }
 
-                // Setup vertex attribute bindings
-                glVertexArrayVertexBuffer(batch.vao_slice, binding_pos, batch.buffer_slice_vertices, 0, sizeof(glm::vec4));
-                glVertexArrayVertexBuffer(batch.vao_slice, binding_col, batch.buffer_slice_hyperplane_normals, 0, sizeof(glm::vec4));
+                // Cell `i` owns the edges in the (global) range `first, first + count` of `cell_edges`
+                const auto first_cell_edge = static_cast<uint32_t>(cell_edges.size / (sizeof(uint32_t) * 2));
+                std::vector<glm::uvec2> cell_ranges_data;
+                for (size_t cell = 0; cell < mesh.number_of_cells; ++cell)
+                {
+                    cell_ranges_data.push_back({
+                        first_cell_edge + tetrahedra.cell_offsets[cell],
+                        tetrahedra.cell_offsets[cell + 1] - tetrahedra.cell_offsets[cell]
+                    });
+                }
 
-                std::array<int32_t, 3> local_size;
-                glGetProgramiv(compute.get_handle(), GL_COMPUTE_WORK_GROUP_SIZE, local_size.data());
+                cell_ranges.append(cell_ranges_data.data(), cell_ranges_data.size() * sizeof(glm::uvec2));
+                cell_edges.append(tetrahedra.cell_edges.data(), tetrahedra.cell_edges.size() * sizeof(uint32_t));
+                cell_normals.append(cell_normals_data.data(), cell_normals_data.size() * sizeof(glm::vec4));
+                cell_tetrahedra.append(cell_tetrahedra_data.data(), cell_tetrahedra_data.size() * sizeof(uint32_t));
             }
 
-            // Compute the indices required to render a wireframe of all of this polychoron's tetrahedra
-            std::vector<uint32_t> tetrahedra_indices;
-            for (size_t simplex_index = 0; simplex_index < tetrahedra.simplices.size() / 4; ++simplex_index)
+            // Keep a copy of the vertices and tetrahedra around, for building each object's sweep order (see `update_sweep(...)`)
+            mesh.vertices = simd::Points{ tetrahedra.vertices };
+            mesh.simplices = std::move(simplices_data);
+
+            const std::vector<glm::vec4> points(tetrahedra.vertices.begin(), tetrahedra.vertices.end());
+            mesh.bounds = bvh::Bounds::from_points(points);
+            mesh.sphere = bvh::Sphere::from_points(points);
+
+            meshes.push_back(std::move(mesh));
+
+            return add_object(meshes.size() - 1, transform);
+        }
+
+        /// Adds another object to the scene that shares the geometry of the object at `index` (rather than duplicating it),
+        /// but has its own transform. Returns the index of the new object.
+        size_t add_instance(size_t index, const glm::mat4& transform = glm::mat4{ 1.0f }, const glm::vec4& translation = glm::vec4{ 0.0f })
+        {
+            return add_object(batches[index].mesh, transform, translation);
+        }
+
+        size_t get_number_of_objects() const
+        {
+            return batches.size();
+        }
+
+        /// Slices all of the objects in the scene at once: each pass is a single dispatch over the elements (vertices,
+        /// edges, tetrahedra, or cells) of every object, which look up their mesh and output ranges in a buffer
+        /// of per-object descriptors (and their transform in a buffer of per-object transforms). The tetrahedra of each
+        /// object are grouped into clusters, and only the clusters whose extent along the hyperplane normal contains the
+        /// hyperplane are considered (see `update_sweep(...)`): these are culled against the hyperplane on the GPU before
+        /// any of their tetrahedra are sliced.
+        ///
+        /// If kinetic slicing is enabled and only the hyperplane's displacement has changed since the last slice, the
+        /// tetrahedra pass is skipped entirely as long as the hyperplane hasn't crossed any vertex: in that case, the 
+        /// slice triangles (which refer to edges) stay the same, and only the edge intersections need to be updated. The
+        /// vertices themselves are only transformed again when an object moves: otherwise, only their distances to the
+        /// hyperplane are updated.
+        ///
+        /// Objects that are hidden, that the hyperplane can't possibly touch, or that are out of view (see `update_culling(...)`),
+        /// are skipped by every pass: each pass only dispatches over the elements of the objects that remain.
+        void slice_objects(const Hyperplane& hyperplane)
+        {
+            if (batches.empty())
             {
-                // Grab the vertex IDs of this simplex
-                auto a = tetrahedra.simplices[simplex_index * 4 + 0];
-                auto b = tetrahedra.simplices[simplex_index * 4 + 1];
-                auto c = tetrahedra.simplices[simplex_index * 4 + 2];
-                auto d = tetrahedra.simplices[simplex_index * 4 + 3];
-        
-                // Each simplex has 6 unique edges, we can easily enumerate these: { (0, 1), (0, 2), (0, 3), (1, 2), (1, 3), (2, 3) }
-                tetrahedra_indices.push_back(a);
-                tetrahedra_indices.push_back(b);
+                return;
+            }
+            upload_instances();
 
-                tetrahedra_indices.push_back(a);
-                tetrahedra_indices.push_back(c);
+            const bool culling_changed = update_culling(hyperplane);
+            bool topology_unchanged = kinetic_slicing && topology_valid && hyperplane.normal == sliced_normal && !culling_changed;
 
-                tetrahedra_indices.push_back(a);
-                tetrahedra_indices.push_back(d);
+            // The transformed vertices only depend on the objects' transforms, so they can be reused until one of them moves
+            // (or until an object that was culled needs to be sliced again)
+            const bool transform_vertices = !transforms_valid || culling_changed;
 
-                tetrahedra_indices.push_back(b);
-                tetrahedra_indices.push_back(c);
+            size_t number_of_visible_vertices = 0;
+            size_t number_of_visible_slice_edges = 0;
+            size_t number_of_visible_cells = 0;
+            size_t number_of_active_clusters = 0;
+            for (size_t index = 0; index < batches.size(); index++)
+            {
+                auto& batch = batches[index];
+                const auto& mesh = meshes[batch.mesh];
+
+                batch.first_visible_vertex = number_of_visible_vertices;
+                batch.first_visible_slice_edge = number_of_visible_slice_edges;
+                batch.first_visible_cell = number_of_visible_cells;
+                batch.first_active_cluster = number_of_active_clusters;
+                batch.number_of_active_clusters = 0;
+                if (batch.culled)
+                {
+                    continue;
+                }
 
-                tetrahedra_indices.push_back(b);
-                tetrahedra_indices.push_back(d);
+                number_of_visible_vertices += mesh.number_of_vertices;
+                number_of_visible_slice_edges += mesh.number_of_slice_edges;
+                if (is_slicing_cells(index))
+                {
+                    // Objects whose cells are sliced directly are handled by `compute_slice_cells.glsl` instead
+                    number_of_visible_cells += mesh.number_of_cells;
+                }
+                else
+                {
+                    const size_t previous_event = batch.event;
+                    const bool previously_near_event = batch.near_event;
 
-                tetrahedra_indices.push_back(c);
-                tetrahedra_indices.push_back(d);
+                    update_sweep(index, hyperplane);
+
+                    topology_unchanged &= batch.event == previous_event && !previously_near_event && !batch.near_event;
+                }
+                number_of_active_clusters += batch.number_of_active_clusters;
             }
 
+            // Upload the per-object descriptors (and empty draw commands, which the compute shaders will append to)
+            std::vector<ObjectDescriptor> descriptors_data;
+            std::vector<DrawElementsCommand> commands_data;
+            std::vector<DrawCommand> cell_commands_data;
+            for (size_t index = 0; index < batches.size(); index++)
             {
-                glCreateVertexArrays(1, &batch.vao_skeleton);
+                const auto& batch = batches[index];
+                const auto& mesh = meshes[batch.mesh];
+
+                ObjectDescriptor descriptor = {};
+                descriptor.first_vertex = mesh.first_vertex;
+                descriptor.first_instance_vertex = batch.first_instance_vertex;
+                descriptor.first_slice_edge = mesh.first_slice_edge;
+                descriptor.first_instance_slice_edge = batch.first_instance_slice_edge;
+                descriptor.first_tetrahedron = mesh.first_tetrahedron;
+                descriptor.first_instance_tetrahedron = batch.first_instance_tetrahedron;
+                descriptor.first_cell = mesh.first_cell;
+                descriptor.first_instance_cell = batch.first_instance_cell;
+                descriptor.first_cell_slice_vertex = batch.first_cell_slice_vertex;
+                descriptor.flip_winding = is_winding_flipped(index, hyperplane);
+                descriptor.slice_cells = is_slicing_cells(index);
+                descriptor.first_cluster = mesh.first_cluster;
+                descriptor.first_active_cluster = batch.first_active_cluster;
+                descriptor.first_sweep_cluster = batch.first_instance_cluster + batch.first_sweep_cluster;
+                descriptor.first_visible_vertex = batch.first_visible_vertex;
+                descriptor.first_visible_slice_edge = batch.first_visible_slice_edge;
+                descriptor.first_visible_cell = batch.first_visible_cell;
+                descriptors_data.push_back(descriptor);
+
+                // Any tetrahedral slice can have at most 6 vertices (a quadrilateral, 2 triangles), so each object's range of the
+                // (tightly packed) slice indices must be large enough to hold the worst case, where every tetrahedron is sliced:
+                // each triangle's color is then found via `gl_BaseInstance + gl_PrimitiveID` (see `projections.frag`)
+                DrawElementsCommand command = {};
+                command.instance_count = 1;
+                command.first_index = batch.first_instance_tetrahedron * max_vertices_per_slice;
+                command.base_instance = batch.first_instance_tetrahedron * max_triangles_per_slice;
+                commands_data.push_back(command);
+
+                DrawCommand cell_command = {};
+                cell_command.instance_count = 1;
+                cell_command.first = batch.first_cell_slice_vertex;
+                cell_command.base_instance = batch.first_cell_slice_vertex / 3;
+                cell_commands_data.push_back(cell_command);
+            }
+            glNamedBufferSubData(descriptors.id, 0, descriptors_data.size() * sizeof(ObjectDescriptor), descriptors_data.data());
+            if (!topology_unchanged)
+            {
+                glNamedBufferSubData(indirect_commands.id, 0, commands_data.size() * sizeof(DrawElementsCommand), commands_data.data());
+
+                const DispatchCommand dispatch_command = { 0, 1, 1, 0 };
+                glNamedBufferSubData(cluster_dispatch.id, 0, sizeof(DispatchCommand), &dispatch_command);
+            }
+            glNamedBufferSubData(cell_indirect_commands.id, 0, cell_commands_data.size() * sizeof(DrawCommand), cell_commands_data.data());
+
+            // Transform each unique vertex of each object (and find its signed distance to the hyperplane) exactly once, up front:
+            // if none of the objects have moved, only the distances are recomputed
+            compute_transform.use();
 
-                // The indices that will be used to draw the wireframes of all of the tetrahedra that make up this polychoron
-                glCreateBuffers(1, &batch.ebo_tetrahedra);
-                glNamedBufferData(batch.ebo_tetrahedra, tetrahedra_indices.size() * sizeof(uint32_t), tetrahedra_indices.data(), GL_STATIC_DRAW);
+            compute_transform.uniform_bool("u_transform", transform_vertices);
+            compute_transform.uniform_vec4("u_hyperplane_normal", hyperplane.normal);
+            compute_transform.uniform_float("u_hyperplane_displacement", hyperplane.displacement);
+            compute_transform.uniform_int("u_number_of_vertices", number_of_visible_vertices);
+            compute_transform.uniform_int("u_number_of_objects", batches.size());
+            compute_transform.uniform_bool("u_compact", vertex_format == VertexFormat::COMPACT);
 
-                // The indices that will be used to draw the "skeleton" (i.e. unique edges) of this polychoron
-                glCreateBuffers(1, &batch.ebo_edges);
-                glNamedBufferData(batch.ebo_edges, tetrahedra.edges.size() * sizeof(uint32_t), tetrahedra.edges.data(), GL_STATIC_DRAW);
-            
-                // The buffer containing all of the unique vertices of this polychoron
-                glCreateBuffers(1, &batch.buffer_vertices);
-                glNamedBufferData(batch.buffer_vertices, tetrahedra.vertices.size() * sizeof(glm::vec4), tetrahedra.vertices.data(), GL_STATIC_DRAW);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, vertices.id);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, transformed_vertices.id);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, vertex_distances.id);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, descriptors.id);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, instances.id);
 
-                // Set up attribute #0: positions
-                glEnableVertexArrayAttrib(batch.vao_skeleton, 0);
-                glVertexArrayAttribFormat(batch.vao_skeleton, 0, 4, GL_FLOAT, GL_FALSE, 0);
-                glVertexArrayAttribBinding(batch.vao_skeleton, 0, 0);
+            dispatch(number_of_visible_vertices);
+            transforms_valid = true;
 
-                // Setup vertex attribute bindings
-                glVertexArrayVertexBuffer(batch.vao_skeleton, 0, batch.buffer_vertices, 0, sizeof(float) * 4);
+            // Barrier against the SSBO reads in the slicing passes
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT);
 
-                // Bind the EBO to the VAO (this might be switched during rendering)
-                glVertexArrayElementBuffer(batch.vao_skeleton, batch.ebo_tetrahedra);
+            // First pass: intersect each unique edge with the hyperplane
+            compute_edges.use();
+
+            compute_edges.uniform_int("u_number_of_edges", number_of_visible_slice_edges);
+            compute_edges.uniform_int("u_number_of_objects", batches.size());
+            compute_edges.uniform_bool("u_compact", vertex_format == VertexFormat::COMPACT);
+
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, transformed_vertices.id);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, slice_edges.id);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, slice_vertices.id);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, vertex_distances.id);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, descriptors.id);
+
+            dispatch(number_of_visible_slice_edges);
+
+            // Note that the second pass only refers to the edge intersections by index (it never reads them), so no
+            // barrier is needed between the two passes
+
+            // Second pass: each tetrahedron that survived cluster culling appends the triangles of its slice (if any) to its
+            // object's range of the slice indices, as indices into the edge intersections (unless the previous triangles are
+            // still valid)
+            if (!topology_unchanged && number_of_active_clusters > 0)
+            {
+                // Cull each active cluster against the hyperplane (via its bounding sphere), appending the tetrahedra of the
+                // clusters that remain to a list of work items: this also sets up the size of the next dispatch
+                compute_clusters.use();
+
+                compute_clusters.uniform_vec4("u_hyperplane_normal", hyperplane.normal);
+                compute_clusters.uniform_float("u_hyperplane_displacement", hyperplane.displacement);
+                compute_clusters.uniform_int("u_number_of_clusters", number_of_active_clusters);
+                compute_clusters.uniform_int("u_number_of_objects", batches.size());
+
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, clusters.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, sweep_orders.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, descriptors.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, instances.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, active_tetrahedra.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, cluster_dispatch.id);
+
+                dispatch(number_of_active_clusters);
+
+                // Barrier against the SSBO reads (and the indirect dispatch) below
+                glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+                compute.use();
+
+                // Bind buffers for read / write
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, tetrahedra_edges.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, slice_indices.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, indirect_commands.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, slice_primitives.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, simplices.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, vertex_distances.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, descriptors.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, active_tetrahedra.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, cluster_dispatch.id);
+
+                glBindBuffer(GL_DISPATCH_INDIRECT_BUFFER, cluster_dispatch.id);
+                glDispatchComputeIndirect(0);
             }
 
-            batches.push_back(batch);
+            // Slice each of the cells directly (rather than their tetrahedra), for any objects that support it,
+            // producing a single convex polygon per cell
+            if (number_of_visible_cells > 0)
+            {
+                compute_cells.use();
+
+                compute_cells.uniform_vec4("u_hyperplane_normal", hyperplane.normal);
+                compute_cells.uniform_int("u_number_of_cells", number_of_visible_cells);
+                compute_cells.uniform_int("u_number_of_objects", batches.size());
+
+                // Bind buffers for read / write
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, transformed_vertices.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, cell_ranges.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, cell_edges.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 3, cell_slice_vertices.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 4, cell_indirect_commands.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 5, cell_normals.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 6, cell_slice_primitives.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 7, vertex_distances.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 8, descriptors.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 9, instances.id);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 10, cell_tetrahedra.id);
+
+                dispatch(number_of_visible_cells);
+            }
+
+            // Barrier against subsequent SSBO reads, index / vertex fetches, and indirect drawing commands
+            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_ELEMENT_ARRAY_BARRIER_BIT | GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+
+            sliced_normal = hyperplane.normal;
+            topology_valid = true;
         }
 
-        size_t get_number_of_objects() const
+        /// Returns `true` if the slice triangles of this object's (positively oriented) tetrahedra would face inwards
+        /// after being projected from 4D to 3D, which happens if the orthographic projection (i.e. dropping the w-coordinate)
+        /// reverses the orientation of the hyperplane or if the object's transform is a reflection.
+        bool is_winding_flipped(size_t index, const Hyperplane& hyperplane) const
         {
-            return batches.size();
+            return (hyperplane.normal.w < 0.0f) != (glm::determinant(batches[index].transform) < 0.0f);
         }
 
-        void slice_object(size_t index, const Hyperplane& hyperplane) const
+        void set_transform(size_t index, const glm::mat4& transform, const glm::vec4& translation = glm::vec4{ 0.0f })
         {
-            compute.use();
-
-            compute.uniform_vec4("u_hyperplane_normal", hyperplane.normal);
-            compute.uniform_float("u_hyperplane_displacement", hyperplane.displacement);
-            compute.uniform_mat4("u_transform", batches[index].transform);
-            compute.uniform_vec4("u_translation", batches[index].translation);
-            compute.uniform_int("u_object_index", index);
-
-            // Bind buffers for read / write
-            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, batches[index].buffer_tetrahedra);
-            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, batches[index].buffer_slice_vertices);
-            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, batches[index].buffer_indirect_commands);
-
-            uint32_t dispatch = ceilf(batches[index].number_of_tetrahedra / 128.0f);
-            glDispatchCompute(dispatch, 1, 1);
+            batches[index].transform = transform;
+            batches[index].translation = translation;
+            instances_need_upload = true;
+            bounds_need_update = true;
+            topology_valid = false;
+            transforms_valid = false;
+        }
 
-            // Barrier against subsequent SSBO reads and indirect drawing commands
-            glMemoryBarrier(GL_SHADER_STORAGE_BARRIER_BIT | GL_COMMAND_BARRIER_BIT);
+        /// Sets the orientation of the object at `index` (in 4-space): the rotor is only converted to a matrix here,
+        /// so any interpolation or composition should happen on the rotors themselves.
+        void set_orientation(size_t index, const maths::Rotor4& orientation, const glm::vec4& translation = glm::vec4{ 0.0f })
+        {
+            batches[index].orientation = orientation;
+            set_transform(index, orientation.to_matrix(), translation);
         }
 
-        void slice_objects(const Hyperplane& hyperplane) const
+        void set_orientations(const maths::Rotor4& orientation, const glm::vec4& translation = glm::vec4{ 0.0f })
         {
+            const auto transform = orientation.to_matrix();
             for (size_t index = 0; index < batches.size(); index++)
             {
-                slice_object(index, hyperplane);
+                batches[index].orientation = orientation;
+                set_transform(index, transform, translation);
             }
         }
 
-        void set_transform(size_t index, const glm::mat4& transform, const glm::vec4& translation = glm::vec4{ 0.0f })
+        const maths::Rotor4& get_orientation(size_t index) const
         {
-            batches[index].transform = transform;
-            batches[index].translation = translation;
+            return batches[index].orientation;
         }
 
         void set_transforms(const glm::mat4& transform, const glm::vec4& translation = glm::vec4{ 0.0f })
@@ -242,55 +545,522 @@ namespace four
 
         void draw_sliced_object(size_t index) const
         {
-            // First, bind this batch's VAO
-            glBindVertexArray(batches[index].vao_slice);
+            // Culled objects weren't sliced at all
+            if (batches[index].culled)
+            {
+                return;
+            }
+
+            // Slices are colored per triangle, by looking up the normal of the tetrahedron that produced each one (see
+            // `projections.frag`)
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, tetrahedra_normals.id);
 
-            // Bind the buffer that contains indirect draw commands
-            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, batches[index].buffer_indirect_commands);
+            if (is_slicing_cells(index))
+            {
+                glBindVertexArray(vao_slice_cells);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cell_slice_primitives.id);
+                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, cell_indirect_commands.id);
+                glDrawArraysIndirect(GL_TRIANGLES, reinterpret_cast<const void*>(index * sizeof(DrawCommand)));
+                return;
+            }
+
+            // First, bind the shared VAO (and per-triangle tetrahedra)
+            glBindVertexArray(vao_slice);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, slice_primitives.id);
 
-            // Dispatch indirect draw commands
-            glMultiDrawArraysIndirect(GL_TRIANGLES, nullptr, batches[index].number_of_tetrahedra, sizeof(DrawCommand));
+            // Bind the buffer that contains the indirect draw commands (one per object)
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_commands.id);
+
+            // Draw the whole slice at once: the number of indices was determined by the compute shader
+            glDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(index * sizeof(DrawElementsCommand)));
         }
 
+        /// Draws the slices of all of the objects in the scene with (at most) 2 multi-draws: objects whose tetrahedra
+        /// (or cells) weren't sliced simply have an empty draw command in the corresponding buffer.
         void draw_sliced_objects() const
         {
-            for (size_t index = 0; index < batches.size(); index++)
+            if (batches.empty())
             {
-                draw_sliced_object(index);
+                return;
+            }
+
+            glBindVertexArray(vao_slice);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, slice_primitives.id);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, tetrahedra_normals.id);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, indirect_commands.id);
+            glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, nullptr, batches.size(), 0);
+
+            if (slice_cells && number_of_instance_cells > 0)
+            {
+                glBindVertexArray(vao_slice_cells);
+                glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, cell_slice_primitives.id);
+                glBindBuffer(GL_DRAW_INDIRECT_BUFFER, cell_indirect_commands.id);
+                glMultiDrawArraysIndirect(GL_TRIANGLES, nullptr, batches.size(), 0);
             }
         }
 
+        /// Draws either the wireframe of the tetrahedra or the edges of a single object (the vertex shader applies
+        /// the object's transform, see `projections.vert`).
         void draw_skeleton_object(size_t index, bool tetrahedra_wireframes = true) const
         {
-            glBindVertexArray(batches[index].vao_skeleton);
-            
-            if (tetrahedra_wireframes)
+            if (!batches[index].visible)
             {
-                // 6 edges per tetrahedra, 2 components each
-                size_t number_of_tetrahedral_edges = batches[index].number_of_tetrahedra * 6 * 2;
+                return;
+            }
+
+            bind_skeleton(tetrahedra_wireframes);
+            glDrawElementsIndirect(GL_LINES, GL_UNSIGNED_INT, reinterpret_cast<const void*>(index * sizeof(DrawElementsCommand)));
+        }
 
-                glVertexArrayElementBuffer(batches[index].vao_skeleton, batches[index].ebo_tetrahedra);
-                glDrawElements(GL_LINES, number_of_tetrahedral_edges, GL_UNSIGNED_INT, nullptr);
+        /// Draws the skeletons of all of the (visible) objects in the scene with a single multi-draw.
+        void draw_skeleton_objects(bool tetrahedra_wireframes = true) const
+        {
+            if (batches.empty())
+            {
+                return;
             }
-            else
+
+            bind_skeleton(tetrahedra_wireframes);
+            glMultiDrawElementsIndirect(GL_LINES, GL_UNSIGNED_INT, nullptr, batches.size(), 0);
+        }
+
+        /// Toggles between slicing the tetrahedra of each object (the default) and slicing its cells directly:
+        /// the latter only applies to objects whose cell structure is known.
+        void set_slice_cells(bool value)
+        {
+            slice_cells = value;
+            topology_valid = false;
+        }
+
+        /// Toggles kinetic slicing (see `slice_objects(...)`), which is enabled by default.
+        void set_kinetic_slicing(bool value)
+        {
+            kinetic_slicing = value;
+            topology_valid = false;
+        }
+
+        /// Shows or hides the object at `index`: hidden objects are skipped entirely when slicing, and their skeletons
+        /// aren't drawn (the draw commands of hidden objects simply have no instances).
+        void set_visible(size_t index, bool visible)
+        {
+            if (batches[index].visible == visible)
             {
-                // The `number_of_edges` member will be set to the length of the edges EBO / 2, so we 
-                // want to make sure to multiply by 2 again here
-                glVertexArrayElementBuffer(batches[index].vao_skeleton, batches[index].ebo_edges);
-                glDrawElements(GL_LINES, batches[index].number_of_edges * 2, GL_UNSIGNED_INT, nullptr);
+                return;
             }
+            batches[index].visible = visible;
+
+            const uint32_t instance_count = visible ? 1 : 0;
+            const size_t offset = index * sizeof(DrawElementsCommand) + offsetof(DrawElementsCommand, instance_count);
+            glNamedBufferSubData(wireframe_commands.id, offset, sizeof(uint32_t), &instance_count);
+            glNamedBufferSubData(edge_commands.id, offset, sizeof(uint32_t), &instance_count);
         }
 
-        void draw_skeleton_objects(bool tetrahedra_wireframes = true) const
+        bool is_visible(size_t index) const
         {
-            for (size_t index = 0; index < batches.size(); index++)
+            return batches[index].visible;
+        }
+
+        /// Sets the (3D) view-projection matrix that the slices are drawn with, i.e. the product of the matrices that
+        /// `projections.vert` applies to each slice vertex: objects whose slices would lie outside of the resulting frustum
+        /// are skipped while slicing. Returns `true` if any visible object entered or left the frustum since the most recent
+        /// slice, in which case the scene must be sliced again (its culled objects have no slice to draw).
+        bool set_view(const glm::mat4& clip_from_slice)
+        {
+            frustum = bvh::Frustum::from_matrix(clip_from_slice);
+            if (bounds_need_update)
             {
-                draw_skeleton_object(index, tetrahedra_wireframes);
+                return true;
             }
+
+            bool changed = false;
+            for (const auto& batch : batches)
+            {
+                changed |= batch.visible && batch.in_view != frustum.intersects(batch.bounds);
+            }
+            return changed;
+        }
+
+        /// Returns `true` if the object at `index` was skipped during the most recent slice, either because it is hidden,
+        /// because it lies entirely on one side of the hyperplane, or because it lies outside of the view.
+        bool is_culled(size_t index) const
+        {
+            return batches[index].culled;
+        }
+
+        VertexFormat get_vertex_format() const
+        {
+            return vertex_format;
+        }
+
+        /// Returns how far the compact vertex formats are from the full-precision ones for the mesh of the object at `index`
+        /// (this is only measured if the compact formats are in use).
+        const quantize::PrecisionReport& get_precision_report(size_t index) const
+        {
+            return meshes[batches[index].mesh].precision_report;
+        }
+
+        bool is_slicing_cells(size_t index) const
+        {
+            return slice_cells && meshes[batches[index].mesh].number_of_cells > 0;
         }
 
 	private:
 
+        /// Appends a new object (i.e. instance) of the mesh at `mesh_index`: the geometry of the mesh is shared by all
+        /// of its instances, but each of them has its own range of each of the buffers that are written to during slicing.
+        size_t add_object(size_t mesh_index, const glm::mat4& transform, const glm::vec4& translation = glm::vec4{ 0.0f })
+        {
+            const auto& mesh = meshes[mesh_index];
+
+            Batch batch;
+            batch.mesh = mesh_index;
+            batch.transform = transform;
+            batch.translation = translation;
+            batch.first_instance_vertex = number_of_instance_vertices;
+            batch.first_instance_slice_edge = number_of_instance_slice_edges;
+            batch.first_instance_tetrahedron = number_of_instance_tetrahedra;
+            batch.first_instance_cluster = number_of_instance_clusters;
+            batch.first_instance_cell = number_of_instance_cells;
+            batch.first_cell_slice_vertex = number_of_cell_slice_vertices;
+
+            number_of_instance_vertices += mesh.number_of_vertices;
+            number_of_instance_slice_edges += mesh.number_of_slice_edges;
+            number_of_instance_tetrahedra += mesh.number_of_tetrahedra;
+            number_of_instance_clusters += mesh.clusters.size();
+            number_of_instance_cells += mesh.number_of_cells;
+            number_of_cell_slice_vertices += mesh.max_cell_slice_vertices;
+
+            // The draw commands for this object's skeleton never change, so they are only recorded once: note that 
+            // `base_instance` is the index of the object (see `projections.vert`)
+            const uint32_t object_index = batches.size();
+            DrawElementsCommand wireframe_command = { 
+                static_cast<uint32_t>(mesh.number_of_slice_edges * 2), 
+                1, 
+                static_cast<uint32_t>(mesh.first_slice_edge * 2), 
+                static_cast<uint32_t>(mesh.first_vertex), 
+                object_index
+            };
+            DrawElementsCommand edge_command = { 
+                static_cast<uint32_t>(mesh.number_of_edges * 2), 
+                1, 
+                static_cast<uint32_t>(mesh.first_edge * 2), 
+                static_cast<uint32_t>(mesh.first_vertex), 
+                object_index 
+            };
+            wireframe_commands.append(&wireframe_command, sizeof(DrawElementsCommand));
+            edge_commands.append(&edge_command, sizeof(DrawElementsCommand));
+
+            // This object's sweep order starts out unsorted, and it is sorted during the next slice
+            batch.sweep_order.resize(mesh.clusters.size());
+            std::iota(batch.sweep_order.begin(), batch.sweep_order.end(), 0);
+            sweep_orders.append(batch.sweep_order.data(), batch.sweep_order.size() * sizeof(uint32_t));
+
+            batches.push_back(batch);
+
+            // The buffers that will be written to whenever the slicing hyperplane moves only need to be large enough
+            // (their contents are recomputed by the next call to `slice_objects(...)`)
+            transformed_vertices.resize(number_of_instance_vertices * sizeof(glm::vec4));
+            vertex_distances.resize(number_of_instance_vertices * sizeof(float));
+            slice_vertices.resize(number_of_instance_slice_edges * get_slice_vertex_size());
+            slice_indices.resize(number_of_instance_tetrahedra * max_vertices_per_slice * sizeof(uint32_t));
+            slice_primitives.resize(number_of_instance_tetrahedra * max_triangles_per_slice * sizeof(uint32_t));
+            active_tetrahedra.resize(number_of_instance_tetrahedra * sizeof(glm::uvec2));
+            cell_slice_vertices.resize(number_of_cell_slice_vertices * sizeof(glm::vec4));
+            cell_slice_primitives.resize(number_of_cell_slice_vertices / 3 * sizeof(uint32_t));
+            indirect_commands.resize(batches.size() * sizeof(DrawElementsCommand));
+            cell_indirect_commands.resize(batches.size() * sizeof(DrawCommand));
+            descriptors.resize(batches.size() * sizeof(ObjectDescriptor));
+            instances.resize(batches.size() * sizeof(InstanceTransform));
+            instances_need_upload = true;
+            bounds_need_update = true;
+            topology_valid = false;
+            transforms_valid = false;
+
+            attach_buffers();
+
+            return batches.size() - 1;
+        }
+
+        /// Decides which objects to skip while slicing, returning `true` if any of them changed since the last slice. An object
+        /// is culled if it is hidden, if its bounds (both a 4D AABB and a bounding hypersphere, after being transformed)
+        /// lie entirely on one side of `hyperplane`, or if its slice can't be seen (i.e. its AABB, projected along w, lies 
+        /// outside of the view frustum, see `set_view(...)`). The AABBs of all of the objects are organized into a BVH, so that entire
+        /// groups of objects can be rejected at once: it is only rebuilt when an object moves (or is added).
+        bool update_culling(const Hyperplane& hyperplane)
+        {
+            if (bounds_need_update)
+            {
+                std::vector<bvh::Bounds> leaves;
+                for (auto& batch : batches)
+                {
+                    const auto& mesh = meshes[batch.mesh];
+                    batch.bounds = mesh.bounds.transformed(batch.transform, batch.translation);
+                    batch.sphere = mesh.sphere.transformed(batch.transform, batch.translation);
+                    leaves.push_back(batch.bounds);
+                }
+                tree = bvh::Tree{ leaves };
+                bounds_need_update = false;
+            }
+
+            for (auto& batch : batches)
+            {
+                batch.in_view = frustum.intersects(batch.bounds);
+            }
+
+            std::vector<bool> culled(batches.size(), true);
+            tree.query(hyperplane, [&](uint32_t index)
+            {
+                culled[index] = !batches[index].visible || !batches[index].in_view || !batches[index].sphere.intersects(hyperplane);
+            });
+
+            bool changed = false;
+            for (size_t index = 0; index < batches.size(); index++)
+            {
+                changed |= batches[index].culled != culled[index];
+                batches[index].culled = culled[index];
+            }
+            return changed;
+        }
+
+        /// Finds the range of the object at `index`'s clusters that can possibly intersect `hyperplane`. Each object keeps its
+        /// clusters sorted by their minimum height along the hyperplane normal (in the object's local frame). A cluster only
+        /// intersects the hyperplane if the hyperplane's height lies between its minimum and maximum height, so (given the
+        /// largest extent of any cluster) all such clusters form a contiguous interval of the sweep order, which is found via
+        /// binary search. The sweep order only needs to be updated when the object's orientation (or the hyperplane normal)
+        /// changes: since it usually changes gradually, the previous order is nearly sorted, which is handled with an
+        /// insertion sort (falling back to a full sort if too many clusters are out of place).
+        void update_sweep(size_t index, const Hyperplane& hyperplane)
+        {
+            auto& batch = batches[index];
+            const auto& mesh = meshes[batch.mesh];
+
+            // Note that (T * v + t) . n = v . (T^t * n) + t . n
+            const glm::vec4 normal = glm::transpose(batch.transform) * hyperplane.normal;
+
+            if (!batch.sweep_valid || normal != batch.sweep_normal)
+            {
+                std::vector<float> heights;
+                simd::dot(normal, mesh.vertices, heights);
+
+                std::vector<float> min_heights(mesh.clusters.size());
+                batch.sweep_extent = 0.0f;
+                for (size_t cluster_index = 0; cluster_index < mesh.clusters.size(); ++cluster_index)
+                {
+                    const auto& cluster = mesh.clusters[cluster_index];
+
+                    float min_height = std::numeric_limits<float>::max();
+                    float max_height = std::numeric_limits<float>::lowest();
+                    for (size_t i = cluster.first_tetrahedron * 4; i < (cluster.first_tetrahedron + cluster.number_of_tetrahedra) * 4; ++i)
+                    {
+                        min_height = std::min(min_height, heights[mesh.simplices[i]]);
+                        max_height = std::max(max_height, heights[mesh.simplices[i]]);
+                    }
+
+                    min_heights[cluster_index] = min_height;
+                    batch.sweep_extent = std::max(batch.sweep_extent, max_height - min_height);
+                }
+
+                const auto by_height = [&](uint32_t a, uint32_t b) { return min_heights[a] < min_heights[b]; };
+                if (!insertion_sort(batch.sweep_order, by_height, batch.sweep_order.size() * max_sweep_shifts))
+                {
+                    std::sort(batch.sweep_order.begin(), batch.sweep_order.end(), by_height);
+                }
+
+                batch.sweep_heights.resize(batch.sweep_order.size());
+                for (size_t i = 0; i < batch.sweep_order.size(); ++i)
+                {
+                    batch.sweep_heights[i] = min_heights[batch.sweep_order[i]];
+                }
+
+                glNamedBufferSubData(sweep_orders.id, 
+                                     batch.first_instance_cluster * sizeof(uint32_t), 
+                                     batch.sweep_order.size() * sizeof(uint32_t), 
+                                     batch.sweep_order.data());
+
+                // The slice only changes combinatorially when the hyperplane crosses a vertex, so the (sorted) heights of
+                // all of the vertices are the "events" of a sweep along the normal
+                batch.event_heights = std::move(heights);
+                std::sort(batch.event_heights.begin(), batch.event_heights.end());
+
+                batch.sweep_normal = normal;
+                batch.sweep_valid = true;
+            }
+
+            // The height of the hyperplane itself, in the object's local frame (the GPU computes each vertex's distance in 
+            // a slightly different way, so the interval is padded by a small epsilon)
+            const float height = -(glm::dot(hyperplane.normal, batch.translation) + hyperplane.displacement);
+            const auto begin = std::lower_bound(batch.sweep_heights.begin(), batch.sweep_heights.end(), height - batch.sweep_extent - sweep_epsilon);
+            const auto end = std::upper_bound(begin, batch.sweep_heights.end(), height + sweep_epsilon);
+
+            batch.first_sweep_cluster = begin - batch.sweep_heights.begin();
+            batch.number_of_active_clusters = end - begin;
+
+            // Find the pair of events that the hyperplane lies between
+            const auto event = std::upper_bound(batch.event_heights.begin(), batch.event_heights.end(), height);
+            batch.event = event - batch.event_heights.begin();
+            batch.near_event = (event != batch.event_heights.end() && *event - height < sweep_epsilon) ||
+                               (event != batch.event_heights.begin() && height - *(event - 1) < sweep_epsilon);
+        }
+
+        /// Sorts `values` (in place) via an insertion sort, which is fast for sequences that are nearly sorted already:
+        /// returns `false` (leaving `values` partially sorted) if more than `max_shifts` elements had to be moved.
+        template<class T, class Compare>
+        static bool insertion_sort(std::vector<T>& values, Compare compare, size_t max_shifts)
+        {
+            size_t shifts = 0;
+            for (size_t i = 1; i < values.size(); ++i)
+            {
+                const T value = values[i];
+                size_t j = i;
+                while (j > 0 && compare(value, values[j - 1]))
+                {
+                    values[j] = values[j - 1];
+                    --j;
+
+                    if (++shifts > max_shifts)
+                    {
+                        values[j] = value;
+                        return false;
+                    }
+                }
+                values[j] = value;
+            }
+            return true;
+        }
+
+        /// Uploads the transform of each object, if any of them have changed since the last upload.
+        void upload_instances() const
+        {
+            if (!instances_need_upload)
+            {
+                return;
+            }
+
+            std::vector<InstanceTransform> instances_data;
+            instances_data.reserve(batches.size());
+            for (const auto& batch : batches)
+            {
+                instances_data.push_back({ batch.transform, batch.translation });
+            }
+            glNamedBufferSubData(instances.id, 0, instances_data.size() * sizeof(InstanceTransform), instances_data.data());
+
+            instances_need_upload = false;
+        }
+
+        /// Prepares for drawing the skeletons of any objects (either their tetrahedra wireframes or their edges).
+        void bind_skeleton(bool tetrahedra_wireframes) const
+        {
+            upload_instances();
+
+            glBindVertexArray(vao_skeleton);
+            glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, instances.id);
+
+            // Edges that are shared by several tetrahedra are only drawn once
+            glVertexArrayElementBuffer(vao_skeleton, tetrahedra_wireframes ? slice_edges.id : edges.id);
+            glBindBuffer(GL_DRAW_INDIRECT_BUFFER, tetrahedra_wireframes ? wireframe_commands.id : edge_commands.id);
+        }
+
+        /// A GPU-side buffer that can grow over time, as objects are added to the scene.
+        struct GrowableBuffer
+        {
+            /// Appends `bytes` bytes of `data` to the end of this buffer, reallocating it (and copying its existing
+            /// contents) if it is too small.
+            void append(const void* data, size_t bytes)
+            {
+                if (size + bytes > capacity)
+                {
+                    const size_t new_capacity = std::max(capacity * 2, size + bytes);
+
+                    uint32_t new_id;
+                    glCreateBuffers(1, &new_id);
+                    glNamedBufferData(new_id, new_capacity, nullptr, GL_STATIC_DRAW);
+                    if (size > 0)
+                    {
+                        glCopyNamedBufferSubData(id, new_id, 0, 0, size);
+                    }
+                    glDeleteBuffers(1, &id);
+
+                    id = new_id;
+                    capacity = new_capacity;
+                }
+
+                if (bytes > 0)
+                {
+                    glNamedBufferSubData(id, size, bytes, data);
+                }
+                size += bytes;
+            }
+
+            /// Makes this buffer (at least) `bytes` bytes large, discarding its contents if it has to be reallocated.
+            void resize(size_t bytes)
+            {
+                if (bytes > capacity)
+                {
+                    const size_t new_capacity = std::max(capacity * 2, bytes);
+
+                    glDeleteBuffers(1, &id);
+                    glCreateBuffers(1, &id);
+                    glNamedBufferData(id, new_capacity, nullptr, GL_STREAM_DRAW);
+
+                    capacity = new_capacity;
+                }
+                size = bytes;
+            }
+
+            uint32_t id = 0;
+
+            /// The number of bytes that are in use
+            size_t size = 0;
+
+            /// The number of bytes that are allocated
+            size_t capacity = 0;
+        };
+
+        /// Re-attaches the shared vertex (and index) buffers to each VAO, which must be done whenever they are reallocated.
+        void attach_buffers() const
+        {
+            glVertexArrayVertexBuffer(vao_slice, 0, slice_vertices.id, 0, get_slice_vertex_size());
+            glVertexArrayElementBuffer(vao_slice, slice_indices.id);
+
+            glVertexArrayVertexBuffer(vao_slice_cells, 0, cell_slice_vertices.id, 0, sizeof(glm::vec4));
+
+            // The EBO of this VAO is switched during rendering
+            glVertexArrayVertexBuffer(vao_skeleton, 0, vertices.id, 0, get_vertex_size());
+        }
+
+        /// Returns the size (in bytes) of each vertex in `vertices`.
+        size_t get_vertex_size() const
+        {
+            return vertex_format == VertexFormat::COMPACT ? sizeof(uint32_t) * 2 : sizeof(glm::vec4);
+        }
+
+        /// Returns the size (in bytes) of each vertex in `slice_vertices`.
+        size_t get_slice_vertex_size() const
+        {
+            return vertex_format == VertexFormat::COMPACT ? sizeof(uint32_t) * 2 : sizeof(glm::vec4);
+        }
+
+        /// Dispatches the active compute shader once for each of `count` elements (in groups of 128).
+        static void dispatch(size_t count)
+        {
+            if (count > 0)
+            {
+                glDispatchCompute(static_cast<uint32_t>(ceilf(count / 128.0f)), 1, 1);
+            }
+        }
+
+        /// Returns the number of faces of each of the cells in `tetrahedra`, which bounds the number of vertices
+        /// in its slices (read straight from the face lattice, see `Tetrahedra::cell_face_offsets`)
+        static std::vector<size_t> get_faces_per_cell(const TetrahedraView& tetrahedra)
+        {
+            std::vector<size_t> faces_per_cell;
+            for (size_t cell = 0; cell + 1 < tetrahedra.cell_face_offsets.size(); ++cell)
+            {
+                faces_per_cell.push_back(tetrahedra.cell_face_offsets[cell + 1] - tetrahedra.cell_face_offsets[cell]);
+            }
+            return faces_per_cell;
+        }
+
         struct DrawCommand
         {
             uint32_t count;
@@ -299,53 +1069,411 @@ namespace four
             uint32_t base_instance;
         };
 
-        struct Batch
+        struct DrawElementsCommand
+        {
+            uint32_t count;
+            uint32_t instance_count;
+            uint32_t first_index;
+            uint32_t base_vertex;
+            uint32_t base_instance;
+        };
+
+        /// The arguments of `glDispatchComputeIndirect`, followed by the number of work items (i.e. tetrahedra) that the
+        /// dispatch covers: this must match the struct of the same name in the shaders (std430 layout)
+        struct DispatchCommand
+        {
+            uint32_t number_of_groups_x;
+            uint32_t number_of_groups_y;
+            uint32_t number_of_groups_z;
+            uint32_t count;
+        };
+
+        /// A group of tetrahedra that are culled together, i.e. a contiguous range of a mesh's tetrahedra along with their
+        /// bounding sphere (in the mesh's local frame): this must match the struct of the same name in the shaders (std430 layout)
+        struct Cluster
         {
-            /// The vertex array object (VAO) that is used for drawing a 3D slice of this mesh
-            uint32_t vao_slice = 0;
+            glm::vec4 center;
+            float radius;
+            uint32_t first_tetrahedron;
+            uint32_t number_of_tetrahedra;
+            uint32_t padding;
+        };
+        static_assert(sizeof(Cluster) == 32, "`Cluster` must match its std430 layout");
 
-            /// A GPU-side buffer that contains all of the tetrahedra that make up this mesh (4 vertices per tetrahedron)
-            uint32_t buffer_tetrahedra = 0;
+        /// Everything that the compute shaders need to know about a single object, i.e. where its mesh and its own (output)
+        /// ranges of each of the buffers start: this must match the struct of the same name in each of the compute shaders
+        /// (std430 layout)
+        struct ObjectDescriptor
+        {
+            uint32_t first_vertex;
+            uint32_t first_instance_vertex;
+            uint32_t first_slice_edge;
+            uint32_t first_instance_slice_edge;
+            uint32_t first_tetrahedron;
+            uint32_t first_instance_tetrahedron;
+            uint32_t first_cell;
+            uint32_t first_instance_cell;
+            uint32_t first_cell_slice_vertex;
+            uint32_t flip_winding;
+            uint32_t slice_cells;
+            uint32_t first_cluster;
+            uint32_t first_active_cluster;
+            uint32_t first_sweep_cluster;
+            uint32_t first_visible_vertex;
+            uint32_t first_visible_slice_edge;
+            uint32_t first_visible_cell;
+        };
+        static_assert(sizeof(ObjectDescriptor) == 68, "`ObjectDescriptor` must match its std430 layout");
 
-            /// A GPU-side buffer that contains all of the hyperplane normals corresponding to each of the sliced tetrahedra
-            uint32_t buffer_slice_hyperplane_normals = 0;
+        /// The 4D transform of a single object: this must match the struct of the same name in the shaders (std430 layout)
+        struct InstanceTransform
+        {
+            glm::mat4 transform;
+            glm::vec4 translation;
+        };
+        static_assert(sizeof(InstanceTransform) == 80, "`InstanceTransform` must match its std430 layout");
 
-            /// A GPU-side buffer that contains all of the vertices that make up the active 3-dimensional cross-section of this mesh
-            uint32_t buffer_slice_vertices = 0;
+        /// The 6 edges of a tetrahedron, as pairs of (local) vertex indices: this must match the order in `compute_slice.glsl`
+        static constexpr std::array<std::pair<uint32_t, uint32_t>, 6> tetrahedron_edges = { {
+            { 0, 1 }, { 0, 2 }, { 0, 3 }, { 1, 2 }, { 1, 3 }, { 2, 3 }
+        } };
 
-            /// A GPU-side buffer that will be filled with indirect drawing commands via the `compute` program
-            uint32_t buffer_indirect_commands = 0;
+        /// Any tetrahedral slice can have at most 6 vertices (a quadrilateral, 2 triangles)
+        static const size_t max_vertices_per_slice = 6;
+        static const size_t max_triangles_per_slice = 2;
 
-            /// The vertex array object (VAO) that is used for drawing an "outline" of this mesh (either edges or tetrahedra wireframes) 
-            uint32_t vao_skeleton = 0;
+        /// The (average) number of positions that each cluster may move during an incremental update of a sweep order,
+        /// before falling back to a full sort
+        static const size_t max_sweep_shifts = 8;
 
-            /// The index buffer used for rendering tetrahedra wireframes
-            uint32_t ebo_tetrahedra = 0;
+        /// The maximum number of tetrahedra in each cluster
+        static const size_t max_tetrahedra_per_cluster = 64;
 
-            /// The index buffer used for rendering edges (of the entire polychoron)
-            uint32_t ebo_edges = 0;
+        /// The padding that is added to each side of the interval of active clusters
+        static constexpr float sweep_epsilon = 0.0001f;
 
-            /// A GPU-side buffer that contains all of the unique vertices that make up this 4-dimensional mesh
-            uint32_t buffer_vertices = 0;
+        /// The geometry of a single polychoron, i.e. a range of each of the shared (static) buffers
+        struct Mesh
+        {
+            /// The index of this mesh's first vertex (in `vertices`) and the total number of unique vertices that are in this mesh
+            size_t first_vertex = 0;
+            size_t number_of_vertices = 0;
+
+            /// The index of this mesh's first tetrahedron (in `simplices`) and the total number of tetrahedra that are in this mesh
+            size_t first_tetrahedron = 0;
+            size_t number_of_tetrahedra = 0;
+
+            /// The index of this mesh's first edge (in `edges`) and the total number of unique edges that are in this mesh
+            /// (i.e. for the 120-cell, this equals 1200)
+            size_t first_edge = 0;
+            size_t number_of_edges = 0;
+
+            /// The index of this mesh's first tetrahedral edge (in `slice_edges`) and the total number of unique edges of the
+            /// tetrahedra that are in this mesh (which includes edges that are interior to the cells)
+            size_t first_slice_edge = 0;
+            size_t number_of_slice_edges = 0;
+
+            /// The index of this mesh's first cell (in `cell_ranges`) and the total number of cells in this mesh (or 0, if
+            /// cells can't be sliced directly)
+            size_t first_cell = 0;
+            size_t number_of_cells = 0;
+
+            /// The maximum number of vertices in a slice of this mesh's cells
+            size_t max_cell_slice_vertices = 0;
+
+            /// A CPU-side copy of this mesh's vertices (in SoA layout, so that their heights along any normal can be found
+            /// several at a time, see `update_sweep(...)`)
+            simd::Points vertices;
+
+            /// A CPU-side copy of the (mesh-local) indices of the 4 vertices of each tetrahedron
+            std::vector<uint32_t> simplices;
+
+            /// The index of this mesh's first cluster (in `clusters`), and a CPU-side copy of all of its clusters
+            size_t first_cluster = 0;
+            std::vector<Cluster> clusters;
+
+            /// The bounds of this mesh's vertices
+            bvh::Bounds bounds;
+            bvh::Sphere sphere;
+
+            /// The error of the compact vertex formats for this mesh (see `VertexFormat`)
+            quantize::PrecisionReport precision_report;
+        };
+
+        /// Groups the tetrahedra of `tetrahedra` into the clusters of `mesh`, writing the (reordered) tetrahedra and their
+        /// normals to `simplices_data` and `normals_data`. The tetrahedra of each cell are kept together (in the order that
+        /// they were found), and any cell with more than `max_tetrahedra_per_cluster` tetrahedra is split into several
+        /// clusters. If the cells aren't known, consecutive runs of tetrahedra are used instead.
+        static void build_clusters(const TetrahedraView& tetrahedra, 
+                                   Mesh& mesh, 
+                                   std::vector<uint32_t>& simplices_data, 
+                                   std::vector<glm::vec4>& normals_data)
+        {
+            const bool has_cells = tetrahedra.cell_indices.size() == mesh.number_of_tetrahedra;
+            const auto get_cell = [&](uint32_t simplex_index)
+            {
+                return has_cells ? tetrahedra.cell_indices[simplex_index] : 0;
+            };
+
+            std::vector<uint32_t> order(mesh.number_of_tetrahedra);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) { return get_cell(a) < get_cell(b); });
+
+            simplices_data.clear();
+            normals_data.clear();
+            mesh.clusters.clear();
+            for (size_t i = 0; i < order.size(); ++i)
+            {
+                if (i == 0 || 
+                    get_cell(order[i]) != get_cell(order[i - 1]) || 
+                    mesh.clusters.back().number_of_tetrahedra == max_tetrahedra_per_cluster)
+                {
+                    Cluster cluster = {};
+                    cluster.first_tetrahedron = static_cast<uint32_t>(i);
+                    mesh.clusters.push_back(cluster);
+                }
+                mesh.clusters.back().number_of_tetrahedra++;
+
+                simplices_data.insert(simplices_data.end(), tetrahedra.simplices.begin() + order[i] * 4, tetrahedra.simplices.begin() + order[i] * 4 + 4);
+                normals_data.push_back(tetrahedra.normals[order[i]]);
+            }
+
+            // Find the bounding sphere of each cluster
+            std::vector<glm::vec4> points;
+            for (auto& cluster : mesh.clusters)
+            {
+                points.clear();
+                for (size_t i = cluster.first_tetrahedron * 4; i < (cluster.first_tetrahedron + cluster.number_of_tetrahedra) * 4; ++i)
+                {
+                    points.push_back(tetrahedra.vertices[simplices_data[i]]);
+                }
+
+                const auto sphere = bvh::Sphere::from_points(points);
+                cluster.center = sphere.center;
+                cluster.radius = sphere.radius;
+            }
+        }
+
+        /// A single object in the scene, i.e. an instance of a mesh
+        struct Batch
+        {
+            /// The index of this batch's mesh
+            size_t mesh = 0;
 
             /// This batch's transformation matrix (in 4-space)
             glm::mat4 transform = glm::mat4{ 1.0f };
 
+            /// This batch's orientation (in 4-space), if it was set via `set_orientation(...)`: `transform` is derived from it
+            maths::Rotor4 orientation;
+
             /// This batch's translation (in 4-space): note that glm doesn't support 5x5 matrices, so we have to do this
             glm::vec4 translation = glm::vec4{ 0.0f };
 
-            /// The total number of tetrahedra that are in this batch
-            size_t number_of_tetrahedra = 0;
+            /// The start of this batch's range of `transformed_vertices` (and `vertex_distances`)
+            size_t first_instance_vertex = 0;
 
-            /// The total number of unique edges that are in this batch (i.e. for the 120-cell, this equals 1200)
-            size_t number_of_edges = 0;
+            /// The start of this batch's range of `slice_vertices`
+            size_t first_instance_slice_edge = 0;
+
+            /// The start of this batch's range of tetrahedra, which determines its range of `slice_indices` (and `slice_primitives`)
+            size_t first_instance_tetrahedron = 0;
+
+            /// The start of this batch's range of `sweep_orders`
+            size_t first_instance_cluster = 0;
+
+            /// The start of this batch's range of cells
+            size_t first_instance_cell = 0;
+
+            /// The start of this batch's range of `cell_slice_vertices`
+            size_t first_cell_slice_vertex = 0;
+
+            /// The (mesh-local) indices of this batch's clusters, sorted by their minimum height along `sweep_normal`
+            std::vector<uint32_t> sweep_order;
+
+            /// The minimum height of each cluster in `sweep_order`
+            std::vector<float> sweep_heights;
+
+            /// The hyperplane normal (in this batch's local frame) that `sweep_order` was sorted along, and whether or not
+            /// it has been sorted at all
+            glm::vec4 sweep_normal = glm::vec4{ 0.0f };
+            bool sweep_valid = false;
+
+            /// The largest extent of any cluster along `sweep_normal`
+            float sweep_extent = 0.0f;
+
+            /// The interval of `sweep_order` that contains all of the clusters that can possibly intersect the hyperplane
+            size_t first_sweep_cluster = 0;
+            size_t number_of_active_clusters = 0;
+
+            /// The start of this batch's range of active clusters (across all of the objects) in the most recent slice
+            size_t first_active_cluster = 0;
+
+            /// The heights of all of the vertices along `sweep_normal`, in sorted order
+            std::vector<float> event_heights;
+
+            /// The number of vertices that were on the negative side of the hyperplane in the most recent slice, and
+            /// whether or not the hyperplane was close enough to a vertex that the GPU might have disagreed
+            size_t event = 0;
+            bool near_event = true;
+
+            /// The bounds of this batch after being transformed (see `update_culling(...)`)
+            bvh::Bounds bounds;
+            bvh::Sphere sphere;
+
+            /// Whether or not this batch is shown at all, whether or not its bounds were inside of the view frustum during the 
+            /// most recent slice, and whether or not it was skipped during the most recent slice
+            bool visible = true;
+            bool in_view = true;
+            bool culled = false;
+
+            /// The start of this batch's ranges of the vertices, slice edges, and cells that are processed (across all of
+            /// the objects that weren't culled) in the most recent slice
+            size_t first_visible_vertex = 0;
+            size_t first_visible_slice_edge = 0;
+            size_t first_visible_cell = 0;
         };
 
+        // The geometry of all of the 4D objects
+        std::vector<Mesh> meshes;
+
         // All drawable batches of 4D objects
         std::vector<Batch> batches;
 
-        // The compute shader that is used to compute 3-dimensional slices of this mesh
+        // The unique vertices of all of the objects
+        GrowableBuffer vertices;
+
+        // The indices of the 4 vertices of each tetrahedron
+        GrowableBuffer simplices;
+
+        // The indices of the 6 edges of each tetrahedron (into `slice_edges`)
+        GrowableBuffer tetrahedra_edges;
+
+        // The unique edges of the tetrahedra (pairs of vertex indices), which are also used to draw tetrahedra wireframes
+        GrowableBuffer slice_edges;
+
+        // The hyperplane normal of each of the tetrahedra (used as the color of its slice, see `projections.frag`)
+        GrowableBuffer tetrahedra_normals;
+
+        // The unique edges (pairs of vertex indices) of each polychoron, i.e. its "skeleton"
+        GrowableBuffer edges;
+
+        // The (global) range of `cell_edges` that belongs to each cell
+        GrowableBuffer cell_ranges;
+
+        // The edges (pairs of vertex indices) of all of the cells
+        GrowableBuffer cell_edges;
+
+        // The hyperplane normal of each cell (used to orient its slice)
+        GrowableBuffer cell_normals;
+
+        // The (global) index of the first tetrahedron of each cell (used to color its slice)
+        GrowableBuffer cell_tetrahedra;
+
+        // The skeleton draw commands of each object (tetrahedra wireframes and edges, respectively)
+        GrowableBuffer wireframe_commands;
+        GrowableBuffer edge_commands;
+
+        // One `InstanceTransform` per object, which is re-uploaded whenever any of them change
+        GrowableBuffer instances;
+
+        // The clusters of each mesh
+        GrowableBuffer clusters;
+
+        // The sweep order of each object (see `update_sweep(...)`), i.e. a permutation of its mesh's clusters
+        GrowableBuffer sweep_orders;
+
+        // The unique vertices, after each object's transform and translation have been applied
+        GrowableBuffer transformed_vertices;
+
+        // The signed distance between each transformed vertex and the slicing hyperplane
+        GrowableBuffer vertex_distances;
+
+        // The (shared) vertices that make up the active 3-dimensional cross-section of the scene, i.e. the point where
+        // each edge in `slice_edges` crosses the slicing hyperplane
+        GrowableBuffer slice_vertices;
+
+        // The triangles of the active 3-dimensional cross-section (as indices into `slice_vertices`)
+        GrowableBuffer slice_indices;
+
+        // The (global) index of the tetrahedron that produced each of the triangles in `slice_indices`
+        GrowableBuffer slice_primitives;
+
+        // The (triangulated) polygons of the active 3-dimensional cross-section, one per cell
+        GrowableBuffer cell_slice_vertices;
+
+        // The (global) index of the tetrahedron that colors each of the triangles in `cell_slice_vertices`
+        GrowableBuffer cell_slice_primitives;
+
+        // One indirect drawing command per object, which are filled via the `compute` program
+        GrowableBuffer indirect_commands;
+
+        // One indirect drawing command per object, which are filled via the `compute_cells` program
+        GrowableBuffer cell_indirect_commands;
+
+        // One `ObjectDescriptor` per object, which is re-uploaded before every slice
+        GrowableBuffer descriptors;
+
+        // The tetrahedra (of all objects) that survived cluster culling, as pairs of object and (mesh) tetrahedron indices,
+        // along with the indirect dispatch that slices them
+        GrowableBuffer active_tetrahedra;
+        GrowableBuffer cluster_dispatch;
+
+        // The total number of vertices, tetrahedral edges, tetrahedra, and cells across all objects (i.e. the sum over all
+        // of the instances of each mesh)
+        size_t number_of_instance_vertices = 0;
+        size_t number_of_instance_slice_edges = 0;
+        size_t number_of_instance_tetrahedra = 0;
+        size_t number_of_instance_clusters = 0;
+        size_t number_of_instance_cells = 0;
+
+        // The total number of vertices in `cell_slice_vertices` (in the worst case)
+        size_t number_of_cell_slice_vertices = 0;
+
+        // Whether or not `instances` is out-of-date
+        mutable bool instances_need_upload = false;
+
+        // Whether or not `transformed_vertices` still holds the (current) transformed vertices of every object that isn't culled
+        bool transforms_valid = false;
+
+        // The vertex array objects (VAOs) that are used for drawing 3D slices (of tetrahedra or of cells) and "outlines" (either
+        // edges or tetrahedra wireframes)
+        uint32_t vao_slice = 0;
+        uint32_t vao_slice_cells = 0;
+        uint32_t vao_skeleton = 0;
+
+        // The compute shader that transforms the vertices of each object before slicing
+        graphics::Shader compute_transform;
+
+        // The compute shader that culls the clusters of each object against the slicing hyperplane
+        graphics::Shader compute_clusters;
+
+        // The compute shader that intersects the edges of each object with the slicing hyperplane (the first pass)
+        graphics::Shader compute_edges;
+
+        // The compute shader that is used to compute 3-dimensional slices of each object (the second pass)
         graphics::Shader compute;
 
+        // The compute shader that is used to compute 3-dimensional slices of each object, one cell at a time
+        graphics::Shader compute_cells;
+
+        // The layout of `vertices`, `tetrahedra_normals`, and `slice_vertices`
+        VertexFormat vertex_format;
+
+        // Whether or not cells (rather than tetrahedra) should be sliced, where possible
+        bool slice_cells = false;
+
+        bool kinetic_slicing = true;
+
+        // Whether or not the slice triangles from the most recent slice (along `sliced_normal`) are still valid
+        bool topology_valid = false;
+        glm::vec4 sliced_normal{ 0.0f };
+
+        // A BVH over the (transformed) bounds of all of the objects, which is rebuilt whenever any of them move
+        bvh::Tree tree;
+        bool bounds_need_update = true;
+
+        // The (3D) view frustum that the slices are drawn with (see `set_view(...)`), which contains everything by default
+        bvh::Frustum frustum;
+
 	};
 }
\ No newline at end of file
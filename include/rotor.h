@@ -0,0 +1,276 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+
+#include "glm.hpp"
+
+#include "maths.h"
+
+namespace four
+{
+
+    namespace maths
+    {
+
+        /// A bivector in 4-space, i.e. an oriented plane (or a sum of two orthogonal planes), with one component for
+        /// each of the 6 basis planes. When it is used to describe a rotation (see `Rotor4::from_angles(...)`), each
+        /// component is the angle (in radians) of rotation parallel to that plane. Note that a positive angle rotates
+        /// the first axis *away* from the second (i.e. X towards -Y), which only matches some of the matrices in `maths.h`.
+        struct Bivector4
+        {
+            float xy = 0.0f;
+            float xz = 0.0f;
+            float xw = 0.0f;
+            float yz = 0.0f;
+            float yw = 0.0f;
+            float zw = 0.0f;
+
+            Bivector4 operator+(const Bivector4& other) const
+            {
+                return { xy + other.xy, xz + other.xz, xw + other.xw, yz + other.yz, yw + other.yw, zw + other.zw };
+            }
+
+            Bivector4 operator-(const Bivector4& other) const
+            {
+                return { xy - other.xy, xz - other.xz, xw - other.xw, yz - other.yz, yw - other.yw, zw - other.zw };
+            }
+
+            Bivector4 operator*(float scale) const
+            {
+                return { xy * scale, xz * scale, xw * scale, yz * scale, yw * scale, zw * scale };
+            }
+
+            float squared_norm() const
+            {
+                return xy * xy + xz * xz + xw * xw + yz * yz + yw * yw + zw * zw;
+            }
+
+            /// Returns the orthogonal complement of this bivector, i.e. its product with the pseudoscalar `e_xyzw`
+            /// (the dual of the XY-plane is the ZW-plane, etc.).
+            Bivector4 dual() const
+            {
+                return { -zw, yw, -yz, -xw, xz, -xy };
+            }
+        };
+
+        /// A rotor is an element of the even sub-algebra of the 4D geometric algebra (a scalar, 6 bivector
+        /// components, and a pseudoscalar) that represents a rotation about the origin: a vector `v` is rotated via
+        /// the "sandwich" product `R v ~R`. Rotors are to 4-space what quaternions are to 3-space: they compose with
+        /// a single (8x8 component) product, they can be converted to a rotation matrix, and they can be smoothly
+        /// interpolated, which is impossible with a set of composed Euler-like plane angles.
+        ///
+        /// Internally, every rotor splits into two independent "halves" via the idempotents `(1 ± e_xyzw) / 2`,
+        /// each of which behaves exactly like a unit quaternion (this is the familiar decomposition of a 4D rotation
+        /// into a left- and right-isoclinic rotation). This is what makes the exponential and logarithm below
+        /// closed-form, even for double rotations.
+        ///
+        /// Reference: `https://marctenbosch.com/quaternions/` and `https://arxiv.org/abs/2107.03771`
+        class Rotor4
+        {
+
+        public:
+
+            float s = 1.0f;
+            float xy = 0.0f;
+            float xz = 0.0f;
+            float xw = 0.0f;
+            float yz = 0.0f;
+            float yw = 0.0f;
+            float zw = 0.0f;
+            float xyzw = 0.0f;
+
+            Rotor4() = default;
+
+            Rotor4(float s, const Bivector4& bivector, float xyzw) :
+                s{ s },
+                xy{ bivector.xy },
+                xz{ bivector.xz },
+                xw{ bivector.xw },
+                yz{ bivector.yz },
+                yw{ bivector.yw },
+                zw{ bivector.zw },
+                xyzw{ xyzw }
+            {}
+
+            static Rotor4 identity()
+            {
+                return {};
+            }
+
+            /// Returns the rotor that rotates points by `angle` parallel to `plane`: this is equivalent to (and uses the same
+            /// orientation as) `get_simple_rotation_matrix(plane, angle)`.
+            static Rotor4 from_plane(Plane plane, float angle)
+            {
+                // The sign of each angle matches the orientation of the corresponding matrix in `maths.h`
+                Bivector4 angles;
+                switch (plane)
+                {
+                case Plane::XY: angles.xy = angle; break;
+                case Plane::YZ: angles.yz = angle; break;
+                case Plane::ZX: angles.xz = -angle; break;
+                case Plane::XW: angles.xw = angle; break;
+                case Plane::YW: angles.yw = -angle; break;
+                case Plane::ZW: angles.zw = -angle; break;
+                }
+
+                return from_angles(angles);
+            }
+
+            /// The exponential map: returns the rotor `exp(bivector)`. A rotor generated by a bivector rotates by twice the
+            /// bivector's magnitude (which is why `from_angles(...)` halves its argument).
+            static Rotor4 exp(const Bivector4& bivector)
+            {
+                // B^2 = -|B|^2 + q * e_xyzw
+                const float squared_norm = bivector.squared_norm();
+                const float q = 2.0f * (bivector.xy * bivector.zw - bivector.xz * bivector.yw + bivector.xw * bivector.yz);
+
+                // Each half is rotated by its own angle (equal for simple rotations, different for double rotations)
+                const float alpha = std::sqrt(std::max(squared_norm - q, 0.0f));
+                const float beta = std::sqrt(std::max(squared_norm + q, 0.0f));
+
+                const auto dual = bivector.dual();
+                const auto positive = (bivector + dual) * (0.5f * sinc(alpha));
+                const auto negative = (bivector - dual) * (0.5f * sinc(beta));
+
+                return { 0.5f * (std::cos(alpha) + std::cos(beta)), positive + negative, 0.5f * (std::cos(alpha) - std::cos(beta)) };
+            }
+
+            /// Returns the rotor that rotates points by each of the given angles, all at once. This is *not* the same as
+            /// composing the individual plane rotations one after the other, since those do not commute.
+            static Rotor4 from_angles(const Bivector4& angles)
+            {
+                return exp(angles * 0.5f);
+            }
+
+            /// The logarithm of a unit rotor: the inverse of `exp(...)`.
+            Bivector4 log() const
+            {
+                const auto bivector = get_bivector();
+                const auto dual = bivector.dual();
+
+                const auto positive = (bivector + dual) * 0.5f;
+                const auto negative = (bivector - dual) * 0.5f;
+
+                const float alpha = std::atan2(std::sqrt(2.0f * positive.squared_norm()), s + xyzw);
+                const float beta = std::atan2(std::sqrt(2.0f * negative.squared_norm()), s - xyzw);
+
+                return positive * (1.0f / sinc(alpha)) + negative * (1.0f / sinc(beta));
+            }
+
+            /// The composition of two rotations: applying the result is equivalent to applying `other` followed by `this`
+            /// (like a product of rotation matrices).
+            Rotor4 operator*(const Rotor4& b) const
+            {
+                const Rotor4& a = *this;
+
+                Rotor4 result;
+                result.s = a.s * b.s - a.xy * b.xy - a.xz * b.xz - a.xw * b.xw - a.yz * b.yz - a.yw * b.yw - a.zw * b.zw + a.xyzw * b.xyzw;
+                result.xy = a.s * b.xy + a.xy * b.s - a.xz * b.yz + a.yz * b.xz - a.xw * b.yw + a.yw * b.xw - a.zw * b.xyzw - a.xyzw * b.zw;
+                result.xz = a.s * b.xz + a.xz * b.s + a.xy * b.yz - a.yz * b.xy - a.xw * b.zw + a.zw * b.xw + a.yw * b.xyzw + a.xyzw * b.yw;
+                result.xw = a.s * b.xw + a.xw * b.s + a.xy * b.yw - a.yw * b.xy + a.xz * b.zw - a.zw * b.xz - a.yz * b.xyzw - a.xyzw * b.yz;
+                result.yz = a.s * b.yz + a.yz * b.s - a.xy * b.xz + a.xz * b.xy - a.yw * b.zw + a.zw * b.yw - a.xw * b.xyzw - a.xyzw * b.xw;
+                result.yw = a.s * b.yw + a.yw * b.s - a.xy * b.xw + a.xw * b.xy + a.yz * b.zw - a.zw * b.yz + a.xz * b.xyzw + a.xyzw * b.xz;
+                result.zw = a.s * b.zw + a.zw * b.s - a.xz * b.xw + a.xw * b.xz + a.yw * b.yz - a.yz * b.yw - a.xy * b.xyzw - a.xyzw * b.xy;
+                result.xyzw = a.s * b.xyzw + a.xyzw * b.s + a.xy * b.zw + a.zw * b.xy - a.xz * b.yw - a.yw * b.xz + a.xw * b.yz + a.yz * b.xw;
+
+                return result;
+            }
+
+            /// Returns the reverse of this rotor, which (for a unit rotor) is also its inverse.
+            Rotor4 reverse() const
+            {
+                return { s, get_bivector() * -1.0f, xyzw };
+            }
+
+            /// Rescales both halves of the rotor to unit length, which removes any drift that builds up over many compositions.
+            Rotor4 normalized() const
+            {
+                const auto bivector = get_bivector();
+                const auto dual = bivector.dual();
+
+                const auto positive = (bivector + dual) * 0.5f;
+                const auto negative = (bivector - dual) * 0.5f;
+
+                // Each half has a scalar part of `cos(angle) / 2` and a bivector part whose squared norm is `sin(angle)^2 / 2`
+                const float scalar_positive = 0.5f * (s + xyzw);
+                const float scalar_negative = 0.5f * (s - xyzw);
+                const float scale_positive = 1.0f / std::sqrt(4.0f * scalar_positive * scalar_positive + 2.0f * positive.squared_norm());
+                const float scale_negative = 1.0f / std::sqrt(4.0f * scalar_negative * scalar_negative + 2.0f * negative.squared_norm());
+
+                return {
+                    scalar_positive * scale_positive + scalar_negative * scale_negative,
+                    positive * scale_positive + negative * scale_negative,
+                    scalar_positive * scale_positive - scalar_negative * scale_negative
+                };
+            }
+
+            /// Returns the (column-major) rotation matrix that is equivalent to this unit rotor.
+            glm::mat4 to_matrix() const
+            {
+                const float ss = s * s;
+                const float xyxy = xy * xy;
+                const float xzxz = xz * xz;
+                const float xwxw = xw * xw;
+                const float yzyz = yz * yz;
+                const float ywyw = yw * yw;
+                const float zwzw = zw * zw;
+                const float pp = xyzw * xyzw;
+
+                glm::mat4 m;
+                m[0][0] = ss - xyxy - xzxz - xwxw + yzyz + ywyw + zwzw - pp;
+                m[0][1] = -2.0f * (s * xy + xz * yz + xw * yw + xyzw * zw);
+                m[0][2] = -2.0f * (s * xz - xy * yz + xw * zw - xyzw * yw);
+                m[0][3] = -2.0f * (s * xw - xy * yw - xz * zw + xyzw * yz);
+
+                m[1][0] = 2.0f * (s * xy - xz * yz - xw * yw + xyzw * zw);
+                m[1][1] = ss - xyxy + xzxz + xwxw - yzyz - ywyw + zwzw - pp;
+                m[1][2] = -2.0f * (s * yz + xy * xz + yw * zw + xyzw * xw);
+                m[1][3] = -2.0f * (s * yw + xy * xw - yz * zw - xyzw * xz);
+
+                m[2][0] = 2.0f * (s * xz + xy * yz - xw * zw - xyzw * yw);
+                m[2][1] = 2.0f * (s * yz - xy * xz - yw * zw + xyzw * xw);
+                m[2][2] = ss + xyxy - xzxz + xwxw - yzyz + ywyw - zwzw - pp;
+                m[2][3] = -2.0f * (s * zw + xz * xw + yz * yw + xyzw * xy);
+
+                m[3][0] = 2.0f * (s * xw + xy * yw + xz * zw + xyzw * yz);
+                m[3][1] = 2.0f * (s * yw - xy * xw + yz * zw - xyzw * xz);
+                m[3][2] = 2.0f * (s * zw - xz * xw - yz * yw + xyzw * xy);
+                m[3][3] = ss + xyxy + xzxz - xwxw + yzyz - ywyw - zwzw - pp;
+
+                return m;
+            }
+
+            Bivector4 get_bivector() const
+            {
+                return { xy, xz, xw, yz, yw, zw };
+            }
+
+        private:
+
+            /// Returns `sin(x) / x`, which is well-behaved near 0.
+            static float sinc(float x)
+            {
+                return std::abs(x) < 1e-4f ? 1.0f - x * x / 6.0f : std::sin(x) / x;
+            }
+        };
+
+        /// Spherically interpolates between two unit rotors at a constant angular velocity, along the shortest path.
+        ///
+        /// Reference: `https://en.wikipedia.org/wiki/Slerp`
+        Rotor4 slerp(const Rotor4& from, const Rotor4& to, float t)
+        {
+            auto difference = from.reverse() * to;
+
+            // `R` and `-R` represent the same rotation: pick whichever one is closer
+            if (difference.s < 0.0f)
+            {
+                difference = { -difference.s, difference.get_bivector() * -1.0f, -difference.xyzw };
+            }
+
+            return from * Rotor4::exp(difference.log() * t);
+        }
+
+    }
+
+}
\ No newline at end of file
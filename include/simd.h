@@ -0,0 +1,406 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "glm.hpp"
+
+#include "hyperplane.h"
+#include "tetrahedra.h"
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define FOUR_SIMD_X86
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+#endif
+
+// GCC and Clang need to be told which instruction sets each kernel may use (so that the rest of the
+// program can still be compiled for a baseline CPU), whereas MSVC allows any intrinsic anywhere
+#if defined(_MSC_VER) && !defined(__clang__)
+#define FOUR_SIMD_TARGET(isa)
+#define FOUR_SIMD_INLINE __forceinline
+#else
+#define FOUR_SIMD_TARGET(isa) __attribute__((target(isa)))
+#define FOUR_SIMD_INLINE inline __attribute__((always_inline))
+#endif
+
+namespace four
+{
+
+    namespace simd
+    {
+
+        /// A batch of 4D points in structure-of-arrays (SoA) layout, i.e. all of the x-coordinates are stored
+        /// contiguously, followed by all of the y-coordinates, etc. This allows the functions below to process
+        /// 4, 8, or 16 points per instruction (depending on the instruction set).
+        struct Points
+        {
+            Points() = default;
+
+            explicit Points(size_t size)
+            {
+                resize(size);
+            }
+
+            explicit Points(const Span<glm::vec4>& points)
+            {
+                resize(points.size());
+                for (size_t i = 0; i < points.size(); ++i)
+                {
+                    set(i, points[i]);
+                }
+            }
+
+            size_t size() const
+            {
+                return x.size();
+            }
+
+            void resize(size_t size)
+            {
+                x.resize(size);
+                y.resize(size);
+                z.resize(size);
+                w.resize(size);
+            }
+
+            glm::vec4 get(size_t i) const
+            {
+                return { x[i], y[i], z[i], w[i] };
+            }
+
+            void set(size_t i, const glm::vec4& point)
+            {
+                x[i] = point.x;
+                y[i] = point.y;
+                z[i] = point.z;
+                w[i] = point.w;
+            }
+
+            /// Converts the batch back into an array-of-structures (AoS) layout.
+            std::vector<glm::vec4> to_vec4s() const
+            {
+                std::vector<glm::vec4> points(size());
+                for (size_t i = 0; i < size(); ++i)
+                {
+                    points[i] = get(i);
+                }
+                return points;
+            }
+
+            std::vector<float> x;
+            std::vector<float> y;
+            std::vector<float> z;
+            std::vector<float> w;
+        };
+
+        /// The instruction sets that the batch functions can be dispatched to, from slowest to fastest.
+        enum class Isa
+        {
+            SCALAR,
+            SSE2,
+            AVX2,
+            AVX512
+        };
+
+        std::string get_isa_name(Isa isa)
+        {
+            switch (isa)
+            {
+            case Isa::SSE2: return "SSE2";
+            case Isa::AVX2: return "AVX2";
+            case Isa::AVX512: return "AVX-512";
+            default: return "Scalar";
+            }
+        }
+
+        /// Returns the fastest instruction set that is supported by this CPU (and OS), which is what all of the
+        /// batch functions use by default. This is only detected once.
+        Isa get_isa()
+        {
+            static const Isa isa = []()
+            {
+#if defined(FOUR_SIMD_X86)
+#if defined(_MSC_VER) && !defined(__clang__)
+                int info[4];
+                __cpuid(info, 0);
+                const int max_leaf = info[0];
+
+                __cpuid(info, 1);
+                const bool sse2 = (info[3] & (1 << 26)) != 0;
+                const bool fma = (info[2] & (1 << 12)) != 0;
+
+                // Make sure that the OS saves the AVX (and AVX-512) registers on context switches
+                const bool osxsave = (info[2] & (1 << 27)) != 0;
+                const uint64_t xcr0 = osxsave ? _xgetbv(0) : 0;
+                const bool os_avx = (xcr0 & 0x6) == 0x6;
+                const bool os_avx512 = (xcr0 & 0xE6) == 0xE6;
+
+                bool avx2 = false;
+                bool avx512f = false;
+                if (max_leaf >= 7)
+                {
+                    __cpuidex(info, 7, 0);
+                    avx2 = (info[1] & (1 << 5)) != 0;
+                    avx512f = (info[1] & (1 << 16)) != 0;
+                }
+
+                if (avx512f && os_avx512) return Isa::AVX512;
+                if (avx2 && fma && os_avx) return Isa::AVX2;
+                if (sse2) return Isa::SSE2;
+#else
+                __builtin_cpu_init();
+                if (__builtin_cpu_supports("avx512f")) return Isa::AVX512;
+                if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) return Isa::AVX2;
+                if (__builtin_cpu_supports("sse2")) return Isa::SSE2;
+#endif
+#endif
+                return Isa::SCALAR;
+            }();
+
+            return isa;
+        }
+
+        namespace detail
+        {
+
+            /// Each instruction set is described by a "lane" type that wraps its intrinsics, so that the kernels below
+            /// only have to be written once.
+            struct Scalar
+            {
+                using type = float;
+                static const size_t width = 1;
+
+                static FOUR_SIMD_INLINE type load(const float* p) { return *p; }
+                static FOUR_SIMD_INLINE void store(float* p, type a) { *p = a; }
+                static FOUR_SIMD_INLINE type set1(float a) { return a; }
+                static FOUR_SIMD_INLINE type add(type a, type b) { return a + b; }
+                static FOUR_SIMD_INLINE type mul(type a, type b) { return a * b; }
+                static FOUR_SIMD_INLINE type fmadd(type a, type b, type c) { return a * b + c; }
+                static FOUR_SIMD_INLINE type div(type a, type b) { return a / b; }
+                static FOUR_SIMD_INLINE type sqrt(type a) { return std::sqrt(a); }
+            };
+
+// Vector arguments are only ever passed between functions that enable the same instruction set, so the
+// warning about `__m256` (etc.) being passed differently depending on the target doesn't apply (and some
+// versions of GCC's AVX-512 headers trip `-Wmaybe-uninitialized` on their own placeholder registers)
+#if !defined(_MSC_VER) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wpsabi"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+
+#if defined(FOUR_SIMD_X86)
+            struct Sse2
+            {
+                using type = __m128;
+                static const size_t width = 4;
+
+                FOUR_SIMD_TARGET("sse2") static FOUR_SIMD_INLINE type load(const float* p) { return _mm_loadu_ps(p); }
+                FOUR_SIMD_TARGET("sse2") static FOUR_SIMD_INLINE void store(float* p, type a) { _mm_storeu_ps(p, a); }
+                FOUR_SIMD_TARGET("sse2") static FOUR_SIMD_INLINE type set1(float a) { return _mm_set1_ps(a); }
+                FOUR_SIMD_TARGET("sse2") static FOUR_SIMD_INLINE type add(type a, type b) { return _mm_add_ps(a, b); }
+                FOUR_SIMD_TARGET("sse2") static FOUR_SIMD_INLINE type mul(type a, type b) { return _mm_mul_ps(a, b); }
+                FOUR_SIMD_TARGET("sse2") static FOUR_SIMD_INLINE type fmadd(type a, type b, type c) { return _mm_add_ps(_mm_mul_ps(a, b), c); }
+                FOUR_SIMD_TARGET("sse2") static FOUR_SIMD_INLINE type div(type a, type b) { return _mm_div_ps(a, b); }
+                FOUR_SIMD_TARGET("sse2") static FOUR_SIMD_INLINE type sqrt(type a) { return _mm_sqrt_ps(a); }
+            };
+
+            struct Avx2
+            {
+                using type = __m256;
+                static const size_t width = 8;
+
+                FOUR_SIMD_TARGET("avx2,fma") static FOUR_SIMD_INLINE type load(const float* p) { return _mm256_loadu_ps(p); }
+                FOUR_SIMD_TARGET("avx2,fma") static FOUR_SIMD_INLINE void store(float* p, type a) { _mm256_storeu_ps(p, a); }
+                FOUR_SIMD_TARGET("avx2,fma") static FOUR_SIMD_INLINE type set1(float a) { return _mm256_set1_ps(a); }
+                FOUR_SIMD_TARGET("avx2,fma") static FOUR_SIMD_INLINE type add(type a, type b) { return _mm256_add_ps(a, b); }
+                FOUR_SIMD_TARGET("avx2,fma") static FOUR_SIMD_INLINE type mul(type a, type b) { return _mm256_mul_ps(a, b); }
+                FOUR_SIMD_TARGET("avx2,fma") static FOUR_SIMD_INLINE type fmadd(type a, type b, type c) { return _mm256_fmadd_ps(a, b, c); }
+                FOUR_SIMD_TARGET("avx2,fma") static FOUR_SIMD_INLINE type div(type a, type b) { return _mm256_div_ps(a, b); }
+                FOUR_SIMD_TARGET("avx2,fma") static FOUR_SIMD_INLINE type sqrt(type a) { return _mm256_sqrt_ps(a); }
+            };
+
+            struct Avx512
+            {
+                using type = __m512;
+                static const size_t width = 16;
+
+                FOUR_SIMD_TARGET("avx512f") static FOUR_SIMD_INLINE type load(const float* p) { return _mm512_loadu_ps(p); }
+                FOUR_SIMD_TARGET("avx512f") static FOUR_SIMD_INLINE void store(float* p, type a) { _mm512_storeu_ps(p, a); }
+                FOUR_SIMD_TARGET("avx512f") static FOUR_SIMD_INLINE type set1(float a) { return _mm512_set1_ps(a); }
+                FOUR_SIMD_TARGET("avx512f") static FOUR_SIMD_INLINE type add(type a, type b) { return _mm512_add_ps(a, b); }
+                FOUR_SIMD_TARGET("avx512f") static FOUR_SIMD_INLINE type mul(type a, type b) { return _mm512_mul_ps(a, b); }
+                FOUR_SIMD_TARGET("avx512f") static FOUR_SIMD_INLINE type fmadd(type a, type b, type c) { return _mm512_fmadd_ps(a, b, c); }
+                FOUR_SIMD_TARGET("avx512f") static FOUR_SIMD_INLINE type div(type a, type b) { return _mm512_div_ps(a, b); }
+                FOUR_SIMD_TARGET("avx512f") static FOUR_SIMD_INLINE type sqrt(type a) { return _mm512_sqrt_ps(a); }
+            };
+#endif
+
+            // The kernels below are written once, in terms of a lane type `V`, and then stamped out for each instruction set
+            // (rather than being templates) so that every function that touches a vector register is compiled for the right
+            // target: GCC and Clang refuse to inline intrinsics into a template that doesn't enable them. Each kernel only
+            // processes points `[begin, end)`, where `end - begin` must be a multiple of the lane width.
+#define FOUR_SIMD_DEFINE_KERNELS(name, target, V)                                                                                   \
+            /* Computes `out = matrix * in + translation` (note that glm matrices are column-major) */                             \
+            target inline void transform_##name(const glm::mat4& matrix, const glm::vec4& translation, const Points& in, Points& out, size_t begin, size_t end) \
+            {                                                                                                                       \
+                V::type m[4][4];                                                                                                    \
+                V::type t[4];                                                                                                       \
+                for (size_t row = 0; row < 4; ++row)                                                                                \
+                {                                                                                                                   \
+                    for (size_t column = 0; column < 4; ++column)                                                                   \
+                    {                                                                                                               \
+                        m[row][column] = V::set1(matrix[column][row]);                                                              \
+                    }                                                                                                               \
+                    t[row] = V::set1(translation[row]);                                                                             \
+                }                                                                                                                   \
+                                                                                                                                    \
+                float* const outputs[4] = { out.x.data(), out.y.data(), out.z.data(), out.w.data() };                               \
+                for (size_t i = begin; i < end; i += V::width)                                                                      \
+                {                                                                                                                   \
+                    const auto x = V::load(in.x.data() + i);                                                                        \
+                    const auto y = V::load(in.y.data() + i);                                                                        \
+                    const auto z = V::load(in.z.data() + i);                                                                        \
+                    const auto w = V::load(in.w.data() + i);                                                                        \
+                    for (size_t row = 0; row < 4; ++row)                                                                            \
+                    {                                                                                                               \
+                        V::store(outputs[row] + i, V::fmadd(m[row][0], x, V::fmadd(m[row][1], y, V::fmadd(m[row][2], z, V::fmadd(m[row][3], w, t[row]))))); \
+                    }                                                                                                               \
+                }                                                                                                                   \
+            }                                                                                                                       \
+                                                                                                                                    \
+            /* Computes `out = dot(vector, in) + offset` */                                                                         \
+            target inline void dot_##name(const glm::vec4& vector, float offset, const Points& in, float* out, size_t begin, size_t end) \
+            {                                                                                                                       \
+                const auto vx = V::set1(vector.x);                                                                                  \
+                const auto vy = V::set1(vector.y);                                                                                  \
+                const auto vz = V::set1(vector.z);                                                                                  \
+                const auto vw = V::set1(vector.w);                                                                                  \
+                const auto o = V::set1(offset);                                                                                     \
+                for (size_t i = begin; i < end; i += V::width)                                                                      \
+                {                                                                                                                   \
+                    V::store(out + i, V::fmadd(vx, V::load(in.x.data() + i),                                                        \
+                                      V::fmadd(vy, V::load(in.y.data() + i),                                                        \
+                                      V::fmadd(vz, V::load(in.z.data() + i),                                                        \
+                                      V::fmadd(vw, V::load(in.w.data() + i), o)))));                                                \
+                }                                                                                                                   \
+            }                                                                                                                       \
+                                                                                                                                    \
+            /* Normalizes the points in place */                                                                                    \
+            target inline void normalize_##name(Points& points, size_t begin, size_t end)                                          \
+            {                                                                                                                       \
+                for (size_t i = begin; i < end; i += V::width)                                                                      \
+                {                                                                                                                   \
+                    const auto x = V::load(points.x.data() + i);                                                                    \
+                    const auto y = V::load(points.y.data() + i);                                                                    \
+                    const auto z = V::load(points.z.data() + i);                                                                    \
+                    const auto w = V::load(points.w.data() + i);                                                                    \
+                    const auto length = V::sqrt(V::fmadd(x, x, V::fmadd(y, y, V::fmadd(z, z, V::mul(w, w)))));                     \
+                    V::store(points.x.data() + i, V::div(x, length));                                                               \
+                    V::store(points.y.data() + i, V::div(y, length));                                                               \
+                    V::store(points.z.data() + i, V::div(z, length));                                                               \
+                    V::store(points.w.data() + i, V::div(w, length));                                                               \
+                }                                                                                                                   \
+            }
+
+            FOUR_SIMD_DEFINE_KERNELS(scalar, , Scalar)
+#if defined(FOUR_SIMD_X86)
+            FOUR_SIMD_DEFINE_KERNELS(sse2, FOUR_SIMD_TARGET("sse2"), Sse2)
+            FOUR_SIMD_DEFINE_KERNELS(avx2, FOUR_SIMD_TARGET("avx2,fma"), Avx2)
+            FOUR_SIMD_DEFINE_KERNELS(avx512, FOUR_SIMD_TARGET("avx512f"), Avx512)
+#endif
+
+#undef FOUR_SIMD_DEFINE_KERNELS
+
+#if !defined(_MSC_VER) || defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
+
+        }
+
+        /// Returns the number of points that the kernels for `isa` process at once.
+        size_t get_width(Isa isa)
+        {
+            switch (isa)
+            {
+            case Isa::SSE2: return 4;
+            case Isa::AVX2: return 8;
+            case Isa::AVX512: return 16;
+            default: return 1;
+            }
+        }
+
+        /// Computes `out[i] = matrix * in[i] + translation` for all points. `out` is resized to match `in` (and may be the
+        /// same batch as `in`).
+        void transform(const glm::mat4& matrix, const glm::vec4& translation, const Points& in, Points& out, Isa isa = get_isa())
+        {
+            out.resize(in.size());
+
+            // Any points that don't fill a whole register are handled by the scalar kernel
+            const size_t end = in.size() - in.size() % get_width(isa);
+            switch (isa)
+            {
+#if defined(FOUR_SIMD_X86)
+            case Isa::AVX512: detail::transform_avx512(matrix, translation, in, out, 0, end); break;
+            case Isa::AVX2: detail::transform_avx2(matrix, translation, in, out, 0, end); break;
+            case Isa::SSE2: detail::transform_sse2(matrix, translation, in, out, 0, end); break;
+#endif
+            default: detail::transform_scalar(matrix, translation, in, out, 0, end); break;
+            }
+            detail::transform_scalar(matrix, translation, in, out, end, in.size());
+        }
+
+        /// Computes `out[i] = dot(vector, in[i]) + offset` for all points.
+        void dot(const glm::vec4& vector, float offset, const Points& in, std::vector<float>& out, Isa isa = get_isa())
+        {
+            out.resize(in.size());
+
+            const size_t end = in.size() - in.size() % get_width(isa);
+            switch (isa)
+            {
+#if defined(FOUR_SIMD_X86)
+            case Isa::AVX512: detail::dot_avx512(vector, offset, in, out.data(), 0, end); break;
+            case Isa::AVX2: detail::dot_avx2(vector, offset, in, out.data(), 0, end); break;
+            case Isa::SSE2: detail::dot_sse2(vector, offset, in, out.data(), 0, end); break;
+#endif
+            default: detail::dot_scalar(vector, offset, in, out.data(), 0, end); break;
+            }
+            detail::dot_scalar(vector, offset, in, out.data(), end, in.size());
+        }
+
+        /// Computes `out[i] = dot(vector, in[i])` for all points.
+        void dot(const glm::vec4& vector, const Points& in, std::vector<float>& out, Isa isa = get_isa())
+        {
+            dot(vector, 0.0f, in, out, isa);
+        }
+
+        /// Computes `out[i] = hyperplane.signed_distance(in[i])` for all points.
+        void signed_distances(const Hyperplane& hyperplane, const Points& in, std::vector<float>& out, Isa isa = get_isa())
+        {
+            dot(hyperplane.normal, hyperplane.displacement, in, out, isa);
+        }
+
+        /// Normalizes all points in place.
+        void normalize(Points& points, Isa isa = get_isa())
+        {
+            const size_t end = points.size() - points.size() % get_width(isa);
+            switch (isa)
+            {
+#if defined(FOUR_SIMD_X86)
+            case Isa::AVX512: detail::normalize_avx512(points, 0, end); break;
+            case Isa::AVX2: detail::normalize_avx2(points, 0, end); break;
+            case Isa::SSE2: detail::normalize_sse2(points, 0, end); break;
+#endif
+            default: detail::normalize_scalar(points, 0, end); break;
+            }
+            detail::normalize_scalar(points, end, points.size());
+        }
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+#include "glm.hpp"
+
+namespace four
+{
+
+    struct Tetrahedra
+    {
+        // All of the tetrahedra vertices as a single, flat array (4 vertices per tetrahedra)
+        std::vector<glm::vec4> vertices;
+
+        // All of the simplex indices (4 indices per tetrahedra)
+        std::vector<uint32_t> simplices;
+
+        std::vector<uint32_t> edges;
+
+        // All of the hyperplane normals corresponding to each tetrahedron (from convex hull)
+        std::vector<glm::vec4> normals;
+
+        // The cell (i.e. polyhedral facet of the polychoron) that each tetrahedron is part of
+        std::vector<uint32_t> cell_indices;
+
+        // The edges of each cell, in a compact (CSR) layout: the edges of cell `i` are the vertex index pairs
+        // `cell_edges[2 * j + 0]`, `cell_edges[2 * j + 1]` for `cell_offsets[i] <= j < cell_offsets[i + 1]`
+        std::vector<uint32_t> cell_offsets;
+        std::vector<uint32_t> cell_edges;
+
+        // The offsets of each cell's faces in the face lattice (see `lattice::FaceLattice::cell_faces`): cell `i` has
+        // `cell_face_offsets[i + 1] - cell_face_offsets[i]` faces
+        std::vector<uint32_t> cell_face_offsets;
+    };
+
+    /// A non-owning, read-only view of a contiguous array (i.e. a minimal `std::span`).
+    template<class T>
+    class Span
+    {
+
+    public:
+
+        using value_type = T;
+
+        Span() = default;
+
+        Span(const T* data, size_t size) :
+            pointer{ data },
+            count{ size }
+        {}
+
+        Span(const std::vector<T>& values) :
+            pointer{ values.data() },
+            count{ values.size() }
+        {}
+
+        const T* data() const { return pointer; }
+
+        size_t size() const { return count; }
+
+        bool empty() const { return count == 0; }
+
+        const T* begin() const { return pointer; }
+
+        const T* end() const { return pointer + count; }
+
+        const T& operator[](size_t index) const { return pointer[index]; }
+
+    private:
+
+        const T* pointer = nullptr;
+        size_t count = 0;
+    };
+
+    /// A non-owning view of a set of tetrahedra, whose arrays may live in a `Tetrahedra` 
+    /// instance or somewhere else entirely (for example, a memory-mapped cache file).
+    struct TetrahedraView
+    {
+        TetrahedraView() = default;
+
+        TetrahedraView(const Tetrahedra& tetrahedra) :
+            vertices{ tetrahedra.vertices },
+            simplices{ tetrahedra.simplices },
+            edges{ tetrahedra.edges },
+            normals{ tetrahedra.normals },
+            cell_indices{ tetrahedra.cell_indices },
+            cell_offsets{ tetrahedra.cell_offsets },
+            cell_edges{ tetrahedra.cell_edges },
+            cell_face_offsets{ tetrahedra.cell_face_offsets }
+        {}
+
+        Span<glm::vec4> vertices;
+        Span<uint32_t> simplices;
+        Span<uint32_t> edges;
+        Span<glm::vec4> normals;
+        Span<uint32_t> cell_indices;
+        Span<uint32_t> cell_offsets;
+        Span<uint32_t> cell_edges;
+        Span<uint32_t> cell_face_offsets;
+    };
+    
+    std::array<std::pair<uint32_t, uint32_t>, 6> get_edge_indices()
+    {
+        return { {
+            { 0, 1 },
+            { 0, 2 },
+            { 0, 3 },
+            { 1, 2 },
+            { 1, 3 },
+            { 2, 3 }
+        } };
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,552 @@
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "glm.hpp"
+
+#include "permutations.h"
+
+namespace four
+{
+
+    namespace wythoff
+    {
+
+        /// The four (irreducible, non-prismatic) Coxeter groups that generate all of the
+        /// Wythoffian uniform polychora. Each group is described by a linear Coxeter diagram
+        /// with 4 nodes, where the label between nodes `i` and `i + 1` is listed in the comment.
+        ///
+        /// Reference: `https://en.wikipedia.org/wiki/Uniform_4-polytope#Wythoffian`
+        enum class Group
+        {
+            /// [3, 3, 3]: the 5-cell family (order 120)
+            A4,
+
+            /// [4, 3, 3]: the 8-cell / 16-cell family (order 384)
+            B4,
+
+            /// [3, 4, 3]: the 24-cell family (order 1152)
+            F4,
+
+            /// [5, 3, 3]: the 120-cell / 600-cell family (order 14400)
+            H4
+        };
+
+        /// A Coxeter diagram together with a set of "ringed" nodes. A ringed node means that
+        /// the generating (Wythoff) point lies off of that node's mirror, at unit distance.
+        struct Diagram
+        {
+            Group group;
+            std::array<bool, 4> rings;
+        };
+
+        /// How a particular member of the catalog is constructed: all but two of the convex
+        /// uniform polychora come from Wythoff's construction.
+        enum class Construction
+        {
+            WYTHOFF,
+            SNUB_24_CELL,
+            GRAND_ANTIPRISM
+        };
+
+        struct CatalogEntry
+        {
+            std::string name;
+            Construction construction;
+            Diagram diagram;
+        };
+
+        /// A finite reflection group, stored as the full list of its elements (as 4x4 matrices),
+        /// together with the simple roots (mirror normals) that generate it.
+        struct ReflectionGroup
+        {
+            std::array<glm::dvec4, 4> roots;
+            std::vector<glm::dmat4> elements;
+        };
+
+        /// A hash set of 4-dimensional points that considers two points to be equal if all of their
+        /// coordinates are within `tolerance` of one another. Points are binned into a grid with cells
+        /// that are much larger than `tolerance`: if a point lies near the boundary of a cell, the
+        /// neighboring cell(s) are searched as well.
+        class TolerantPointSet
+        {
+
+        public:
+
+            explicit TolerantPointSet(size_t expected_count, double tolerance = 1e-7) :
+                tolerance{ tolerance },
+                cell_size{ tolerance * 1024.0 }
+            {
+                size_t capacity = 64;
+                while (capacity < expected_count * 2)
+                {
+                    capacity *= 2;
+                }
+                slots.assign(capacity, empty);
+                points.reserve(expected_count);
+            }
+
+            /// Inserts `point` into the set, returning `true` if it was not already present.
+            bool insert(const glm::dvec4& point)
+            {
+                if (contains(point))
+                {
+                    return false;
+                }
+
+                if ((points.size() + 1) * 2 > slots.size())
+                {
+                    grow();
+                }
+                insert_index(static_cast<uint32_t>(points.size()), cell_of(point));
+                points.push_back(point);
+
+                return true;
+            }
+
+            /// All of the unique points that have been inserted so far
+            std::vector<glm::dvec4> points;
+
+        private:
+
+            static constexpr uint32_t empty = std::numeric_limits<uint32_t>::max();
+
+            std::array<int64_t, 4> cell_of(const glm::dvec4& point) const
+            {
+                return {
+                    static_cast<int64_t>(std::floor(point[0] / cell_size)),
+                    static_cast<int64_t>(std::floor(point[1] / cell_size)),
+                    static_cast<int64_t>(std::floor(point[2] / cell_size)),
+                    static_cast<int64_t>(std::floor(point[3] / cell_size))
+                };
+            }
+
+            static size_t hash(const std::array<int64_t, 4>& cell)
+            {
+                uint64_t h = 0x9e3779b97f4a7c15ull;
+                for (const auto coordinate : cell)
+                {
+                    h ^= static_cast<uint64_t>(coordinate);
+                    h *= 0xbf58476d1ce4e5b9ull;
+                    h ^= h >> 31;
+                }
+                return static_cast<size_t>(h);
+            }
+
+            bool contains(const glm::dvec4& point) const
+            {
+                // For each coordinate, figure out whether or not the neighboring cell on either
+                // side could contain a matching point
+                const auto cell = cell_of(point);
+                std::array<int64_t, 4> neighbor_offsets = { 0, 0, 0, 0 };
+                for (size_t i = 0; i < 4; ++i)
+                {
+                    if (std::floor((point[i] - tolerance) / cell_size) < cell[i])
+                    {
+                        neighbor_offsets[i] = -1;
+                    }
+                    else if (std::floor((point[i] + tolerance) / cell_size) > cell[i])
+                    {
+                        neighbor_offsets[i] = 1;
+                    }
+                }
+
+                for (uint32_t combination = 0; combination < 16; ++combination)
+                {
+                    auto candidate = cell;
+                    bool valid = true;
+                    for (size_t i = 0; i < 4; ++i)
+                    {
+                        if (combination & (1u << i))
+                        {
+                            valid &= neighbor_offsets[i] != 0;
+                            candidate[i] += neighbor_offsets[i];
+                        }
+                    }
+                    if (valid && contains_in_cell(point, candidate))
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            bool contains_in_cell(const glm::dvec4& point, const std::array<int64_t, 4>& cell) const
+            {
+                const size_t mask = slots.size() - 1;
+                for (size_t slot = hash(cell) & mask; slots[slot] != empty; slot = (slot + 1) & mask)
+                {
+                    const auto& other = points[slots[slot]];
+                    if (std::abs(other[0] - point[0]) <= tolerance &&
+                        std::abs(other[1] - point[1]) <= tolerance &&
+                        std::abs(other[2] - point[2]) <= tolerance &&
+                        std::abs(other[3] - point[3]) <= tolerance)
+                    {
+                        return true;
+                    }
+                }
+                return false;
+            }
+
+            void insert_index(uint32_t index, const std::array<int64_t, 4>& cell)
+            {
+                const size_t mask = slots.size() - 1;
+                size_t slot = hash(cell) & mask;
+                while (slots[slot] != empty)
+                {
+                    slot = (slot + 1) & mask;
+                }
+                slots[slot] = index;
+            }
+
+            void grow()
+            {
+                slots.assign(slots.size() * 2, empty);
+                for (uint32_t index = 0; index < points.size(); ++index)
+                {
+                    insert_index(index, cell_of(points[index]));
+                }
+            }
+
+            double tolerance;
+            double cell_size;
+            std::vector<uint32_t> slots;
+        };
+
+        /// Returns the labels `m` of the 3 branches of the linear Coxeter diagram of `group`,
+        /// where the angle between the mirrors of adjacent nodes is `pi / m`.
+        std::array<int, 3> get_branch_labels(Group group)
+        {
+            switch (group)
+            {
+            case Group::A4: return { 3, 3, 3 };
+            case Group::B4: return { 4, 3, 3 };
+            case Group::F4: return { 3, 4, 3 };
+            case Group::H4: return { 5, 3, 3 };
+            }
+            return { 3, 3, 3 };
+        }
+
+        /// Returns a set of simple roots (unit mirror normals) for `group`. The roots are found
+        /// by taking the Cholesky decomposition `L * L^T` of the group's Gram matrix, whose
+        /// entries are `-cos(pi / m)`: the rows of `L` then have exactly the required inner
+        /// products with one another.
+        std::array<glm::dvec4, 4> get_simple_roots(Group group)
+        {
+            const double pi = 3.14159265358979323846;
+            const auto labels = get_branch_labels(group);
+
+            double gram[4][4] = {};
+            for (size_t i = 0; i < 4; ++i)
+            {
+                gram[i][i] = 1.0;
+            }
+            for (size_t i = 0; i < 3; ++i)
+            {
+                gram[i][i + 1] = gram[i + 1][i] = -cos(pi / labels[i]);
+            }
+
+            double lower[4][4] = {};
+            for (size_t i = 0; i < 4; ++i)
+            {
+                for (size_t j = 0; j <= i; ++j)
+                {
+                    double sum = gram[i][j];
+                    for (size_t k = 0; k < j; ++k)
+                    {
+                        sum -= lower[i][k] * lower[j][k];
+                    }
+                    lower[i][j] = (i == j) ? sqrt(sum) : sum / lower[j][j];
+                }
+            }
+
+            std::array<glm::dvec4, 4> roots;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                roots[i] = glm::dvec4{ lower[i][0], lower[i][1], lower[i][2], lower[i][3] };
+            }
+            return roots;
+        }
+
+        /// Returns the point whose (signed) distance to the mirror of each simple root is given
+        /// by `distances`. Since the roots form a lower-triangular matrix, this is just forward
+        /// substitution.
+        glm::dvec4 get_point_from_mirror_distances(const std::array<glm::dvec4, 4>& roots, const std::array<double, 4>& distances)
+        {
+            glm::dvec4 point{ 0.0 };
+            for (size_t i = 0; i < 4; ++i)
+            {
+                double sum = distances[i];
+                for (size_t k = 0; k < i; ++k)
+                {
+                    sum -= roots[i][k] * point[k];
+                }
+                point[i] = sum / roots[i][i];
+            }
+            return point;
+        }
+
+        /// Returns the matrix that reflects points across the mirror with unit normal `root`.
+        glm::dmat4 get_reflection_matrix(const glm::dvec4& root)
+        {
+            glm::dmat4 reflection{ 1.0 };
+            for (size_t column = 0; column < 4; ++column)
+            {
+                for (size_t row = 0; row < 4; ++row)
+                {
+                    reflection[column][row] -= 2.0 * root[row] * root[column];
+                }
+            }
+            return reflection;
+        }
+
+        /// Enumerates every element of the reflection group generated by the simple roots of
+        /// `group`. This is done via a breadth-first search: the elements are in one-to-one
+        /// correspondence with the images of a "generic" point (one that doesn't lie on any
+        /// mirror), so these images are used to detect duplicates.
+        ReflectionGroup build_reflection_group(Group group)
+        {
+            ReflectionGroup reflection_group;
+            reflection_group.roots = get_simple_roots(group);
+
+            std::array<glm::dmat4, 4> generators;
+            for (size_t i = 0; i < 4; ++i)
+            {
+                generators[i] = get_reflection_matrix(reflection_group.roots[i]);
+            }
+
+            const auto generic = get_point_from_mirror_distances(reflection_group.roots, { 1.0, 1.0, 1.0, 1.0 });
+
+            TolerantPointSet images{ 14400 };
+            images.insert(generic);
+            reflection_group.elements.push_back(glm::dmat4{ 1.0 });
+
+            for (size_t index = 0; index < reflection_group.elements.size(); ++index)
+            {
+                for (const auto& generator : generators)
+                {
+                    if (images.insert(generator * images.points[index]))
+                    {
+                        reflection_group.elements.push_back(generator * reflection_group.elements[index]);
+                    }
+                }
+            }
+
+            return reflection_group;
+        }
+
+        /// Returns the (cached) reflection group corresponding to `group`. Each group is built
+        /// exactly once, the first time that it is requested.
+        const ReflectionGroup& get_reflection_group(Group group)
+        {
+            switch (group)
+            {
+            case Group::A4: { static const ReflectionGroup a4 = build_reflection_group(Group::A4); return a4; }
+            case Group::B4: { static const ReflectionGroup b4 = build_reflection_group(Group::B4); return b4; }
+            case Group::F4: { static const ReflectionGroup f4 = build_reflection_group(Group::F4); return f4; }
+            case Group::H4: break;
+            }
+            static const ReflectionGroup h4 = build_reflection_group(Group::H4);
+            return h4;
+        }
+
+        /// Returns the (unique) vertices of the uniform polychoron described by `diagram`, i.e. the
+        /// orbit of the Wythoff point under the diagram's reflection group. All vertices are scaled
+        /// so that the polychoron has unit radius.
+        std::vector<glm::vec4> generate(const Diagram& diagram)
+        {
+            if (!diagram.rings[0] && !diagram.rings[1] && !diagram.rings[2] && !diagram.rings[3])
+            {
+                throw std::runtime_error("At least one node of the Coxeter diagram must be ringed");
+            }
+
+            const auto& reflection_group = get_reflection_group(diagram.group);
+
+            const auto wythoff_point = get_point_from_mirror_distances(reflection_group.roots, {
+                diagram.rings[0] ? 1.0 : 0.0,
+                diagram.rings[1] ? 1.0 : 0.0,
+                diagram.rings[2] ? 1.0 : 0.0,
+                diagram.rings[3] ? 1.0 : 0.0
+            });
+
+            TolerantPointSet orbit{ reflection_group.elements.size() };
+            for (const auto& element : reflection_group.elements)
+            {
+                orbit.insert(element * wythoff_point);
+            }
+
+            const double radius = glm::length(wythoff_point);
+
+            std::vector<glm::vec4> vertices;
+            vertices.reserve(orbit.points.size());
+            for (const auto& point : orbit.points)
+            {
+                vertices.push_back(glm::vec4{ point / radius });
+            }
+
+            return vertices;
+        }
+
+        /// The snub 24-cell is not Wythoffian: its 96 vertices are the even permutations (and changes-of-sign)
+        /// of `<phi, 1, 1 / phi, 0>`, i.e. the vertices of the 600-cell that don't belong to an inscribed 24-cell.
+        std::vector<glm::vec4> generate_snub_24_cell()
+        {
+            const float phi = (1.0f + sqrtf(5.0f)) / 2.0f;
+
+            auto vertices = combinatorics::generate({
+                combinatorics::PermutationSeed<float>{ { phi, 1.0f, 1.0f / phi, 0.0f }, true, combinatorics::Parity::EVEN }
+            });
+            for (auto& vertex : vertices)
+            {
+                vertex = glm::normalize(vertex);
+            }
+
+            return vertices;
+        }
+
+        /// The grand antiprism is not Wythoffian either: its 100 vertices are those of the 600-cell, minus the
+        /// 20 vertices that lie on two great decagons in completely orthogonal planes. Here, we find one such
+        /// decagon by following an edge of the 600-cell, which always lies along a great decagon.
+        std::vector<glm::vec4> generate_grand_antiprism()
+        {
+            const float epsilon = 0.0001f;
+            const auto cell_600 = generate({ Group::H4, { false, false, false, true } });
+
+            // Find a neighbor of the first vertex: this is the closest vertex, which is the one with the
+            // largest dot product (since all vertices lie on the unit sphere)
+            const auto& a = cell_600[0];
+            size_t neighbor = 1;
+            for (size_t i = 1; i < cell_600.size(); ++i)
+            {
+                if (glm::dot(a, cell_600[i]) > glm::dot(a, cell_600[neighbor]))
+                {
+                    neighbor = i;
+                }
+            }
+
+            // Build an orthonormal basis for the plane of the decagon
+            const auto& b = cell_600[neighbor];
+            const auto u = a;
+            const auto v = glm::normalize(b - u * glm::dot(u, b));
+
+            std::vector<glm::vec4> vertices;
+            size_t removed = 0;
+            for (const auto& vertex : cell_600)
+            {
+                const float du = glm::dot(vertex, u);
+                const float dv = glm::dot(vertex, v);
+
+                const bool on_first_decagon = glm::length(vertex - u * du - v * dv) < epsilon;
+                const bool on_second_decagon = fabsf(du) < epsilon && fabsf(dv) < epsilon;
+
+                if (on_first_decagon || on_second_decagon)
+                {
+                    removed++;
+                    continue;
+                }
+                vertices.push_back(vertex);
+            }
+
+            if (removed != 20)
+            {
+                throw std::runtime_error("Failed to find the two great decagons of the 600-cell");
+            }
+
+            return vertices;
+        }
+
+        /// Returns the vertices of a single entry in the catalog (see `get_catalog()`).
+        std::vector<glm::vec4> generate(const CatalogEntry& entry)
+        {
+            switch (entry.construction)
+            {
+            case Construction::SNUB_24_CELL: return generate_snub_24_cell();
+            case Construction::GRAND_ANTIPRISM: return generate_grand_antiprism();
+            case Construction::WYTHOFF: break;
+            }
+            return generate(entry.diagram);
+        }
+
+        /// Returns all 47 convex, non-prismatic uniform polychora. Each ring pattern is listed as
+        /// a string of 4 characters (`1` for a ringed node, `0` otherwise), where the first node
+        /// is the one on the left-hand side of the diagram's branch labels (see `Group`). Forms
+        /// that appear in more than one family (i.e. the 24-cell, which is also the rectified
+        /// 16-cell) are only listed once.
+        ///
+        /// Reference: `https://en.wikipedia.org/wiki/Uniform_4-polytope`
+        std::vector<CatalogEntry> get_catalog()
+        {
+            const auto wythoff = [](const std::string& name, Group group, const std::string& rings)
+            {
+                return CatalogEntry{ name, Construction::WYTHOFF, Diagram{ group, { rings[0] == '1', rings[1] == '1', rings[2] == '1', rings[3] == '1' } } };
+            };
+
+            return {
+                // A4
+                wythoff("5-cell", Group::A4, "1000"),
+                wythoff("Rectified 5-cell", Group::A4, "0100"),
+                wythoff("Truncated 5-cell", Group::A4, "1100"),
+                wythoff("Cantellated 5-cell", Group::A4, "1010"),
+                wythoff("Runcinated 5-cell", Group::A4, "1001"),
+                wythoff("Bitruncated 5-cell", Group::A4, "0110"),
+                wythoff("Cantitruncated 5-cell", Group::A4, "1110"),
+                wythoff("Runcitruncated 5-cell", Group::A4, "1101"),
+                wythoff("Omnitruncated 5-cell", Group::A4, "1111"),
+
+                // B4
+                wythoff("8-cell", Group::B4, "1000"),
+                wythoff("Rectified 8-cell", Group::B4, "0100"),
+                wythoff("24-cell", Group::B4, "0010"),
+                wythoff("16-cell", Group::B4, "0001"),
+                wythoff("Truncated 8-cell", Group::B4, "1100"),
+                wythoff("Cantellated 8-cell", Group::B4, "1010"),
+                wythoff("Runcinated 8-cell", Group::B4, "1001"),
+                wythoff("Bitruncated 8-cell", Group::B4, "0110"),
+                wythoff("Rectified 24-cell", Group::B4, "0101"),
+                wythoff("Truncated 16-cell", Group::B4, "0011"),
+                wythoff("Cantitruncated 8-cell", Group::B4, "1110"),
+                wythoff("Runcitruncated 8-cell", Group::B4, "1101"),
+                wythoff("Runcitruncated 16-cell", Group::B4, "1011"),
+                wythoff("Truncated 24-cell", Group::B4, "0111"),
+                wythoff("Omnitruncated 8-cell", Group::B4, "1111"),
+
+                // F4 (the 24-cell, rectified 24-cell, and truncated 24-cell are listed above)
+                wythoff("Cantellated 24-cell", Group::F4, "1010"),
+                wythoff("Runcinated 24-cell", Group::F4, "1001"),
+                wythoff("Bitruncated 24-cell", Group::F4, "0110"),
+                wythoff("Cantitruncated 24-cell", Group::F4, "1110"),
+                wythoff("Runcitruncated 24-cell", Group::F4, "1101"),
+                wythoff("Omnitruncated 24-cell", Group::F4, "1111"),
+
+                // H4
+                wythoff("120-cell", Group::H4, "1000"),
+                wythoff("Rectified 120-cell", Group::H4, "0100"),
+                wythoff("Rectified 600-cell", Group::H4, "0010"),
+                wythoff("600-cell", Group::H4, "0001"),
+                wythoff("Truncated 120-cell", Group::H4, "1100"),
+                wythoff("Cantellated 120-cell", Group::H4, "1010"),
+                wythoff("Runcinated 120-cell", Group::H4, "1001"),
+                wythoff("Bitruncated 120-cell", Group::H4, "0110"),
+                wythoff("Cantellated 600-cell", Group::H4, "0101"),
+                wythoff("Truncated 600-cell", Group::H4, "0011"),
+                wythoff("Cantitruncated 120-cell", Group::H4, "1110"),
+                wythoff("Runcitruncated 120-cell", Group::H4, "1101"),
+                wythoff("Runcitruncated 600-cell", Group::H4, "1011"),
+                wythoff("Cantitruncated 600-cell", Group::H4, "0111"),
+                wythoff("Omnitruncated 120-cell", Group::H4, "1111"),
+
+                // Non-Wythoffian
+                CatalogEntry{ "Snub 24-cell", Construction::SNUB_24_CELL, Diagram{ Group::F4, { false, false, false, false } } },
+                CatalogEntry{ "Grand antiprism", Construction::GRAND_ANTIPRISM, Diagram{ Group::H4, { false, false, false, false } } }
+            };
+        }
+
+    }
+
+}
\ No newline at end of file
@@ -0,0 +1,165 @@
+#version 450
+
+layout(local_size_x = 128, local_size_y = 1, local_size_z = 1) in;
+
+uniform vec4 u_hyperplane_normal;
+uniform float u_hyperplane_displacement;
+
+uniform int u_number_of_clusters;
+uniform int u_number_of_objects;
+
+// This must match `Renderer::ObjectDescriptor`
+struct ObjectDescriptor
+{
+    uint first_vertex;
+    uint first_instance_vertex;
+    uint first_slice_edge;
+    uint first_instance_slice_edge;
+    uint first_tetrahedron;
+    uint first_instance_tetrahedron;
+    uint first_cell;
+    uint first_instance_cell;
+    uint first_cell_slice_vertex;
+    uint flip_winding;
+    uint slice_cells;
+    uint first_cluster;
+    uint first_active_cluster;
+    uint first_sweep_cluster;
+    uint first_visible_vertex;
+    uint first_visible_slice_edge;
+    uint first_visible_cell;
+};
+
+// This must match `Renderer::InstanceTransform`
+struct InstanceTransform
+{
+    mat4 transform;
+    vec4 translation;
+};
+
+// This must match `Renderer::Cluster`
+struct Cluster
+{
+    vec4 center;
+    float radius;
+    uint first_tetrahedron;
+    uint number_of_tetrahedra;
+    uint padding;
+};
+
+// This must match `Renderer::DispatchCommand`
+struct DispatchCommand
+{
+    uint number_of_groups_x;
+    uint number_of_groups_y;
+    uint number_of_groups_z;
+    uint count;
+};
+
+// Read only: the clusters of all of the meshes, i.e. ranges of (mesh-local) tetrahedra and their bounding spheres.
+layout(std430, binding = 0) readonly buffer BUFF_clusters
+{
+    Cluster clusters[];
+};
+
+// Read only: the (mesh-local) indices of each object's clusters, sorted by their minimum height along the
+// hyperplane normal (see `Renderer::update_sweep(...)`).
+layout(std430, binding = 1) readonly buffer BUFF_sweep_orders
+{
+    uint sweep_orders[];
+};
+
+// Read only: the ranges of each of the shared buffers that belong to each object.
+layout(std430, binding = 2) readonly buffer BUFF_objects
+{
+    ObjectDescriptor objects[];
+};
+
+// Read only: the transform of each object.
+layout(std430, binding = 3) readonly buffer BUFF_instances
+{
+    InstanceTransform instances[];
+};
+
+// Write only: the tetrahedra that should be sliced, as pairs of object and tetrahedron indices, tightly packed (in no
+// particular order).
+layout(std430, binding = 4) writeonly buffer BUFF_active_tetrahedra
+{
+    uvec2 active_tetrahedra[];
+};
+
+// Read + write: the indirect dispatch of the second slicing pass, whose `count` is used to allocate space in the
+// buffer above (it must be reset to 0 groups before each dispatch).
+layout(std430, binding = 5) buffer BUFF_dispatch
+{
+    DispatchCommand dispatch;
+};
+
+// Returns the index of the object that owns active cluster `id`, via a binary search over the (sorted) ranges of
+// all of the objects.
+uint find_object(uint id)
+{
+    uint low = 0;
+    uint high = uint(u_number_of_objects) - 1;
+    while (low < high)
+    {
+        uint middle = (low + high + 1) / 2;
+        if (objects[middle].first_active_cluster <= id)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    return low;
+}
+
+// Returns an upper bound on how much `transform` can stretch any vector, i.e. sqrt(|T|_1 * |T|_inf) (see
+// `bvh::Sphere::transformed(...)`).
+float get_scale(in mat4 transform)
+{
+    float max_column_sum = 0.0;
+    float max_row_sum = 0.0;
+    for (int i = 0; i < 4; ++i)
+    {
+        max_column_sum = max(max_column_sum, dot(abs(transform[i]), vec4(1.0)));
+        max_row_sum = max(max_row_sum, dot(abs(vec4(transform[0][i], transform[1][i], transform[2][i], transform[3][i])), vec4(1.0)));
+    }
+    return sqrt(max_column_sum * max_row_sum);
+}
+
+// This runs before the second slicing pass: each active cluster (i.e. one that might intersect the hyperplane,
+// according to its object's sweep order) is tested against the hyperplane via its bounding sphere, and only the
+// tetrahedra of the clusters that pass are handed to `compute_slice.glsl`.
+void main()
+{
+    uint active_id = gl_GlobalInvocationID.x;
+    if (active_id >= uint(u_number_of_clusters))
+    {
+        return;
+    }
+
+    uint object_id = find_object(active_id);
+    ObjectDescriptor object = objects[object_id];
+    uint sweep_id = object.first_sweep_cluster + (active_id - object.first_active_cluster);
+    Cluster cluster = clusters[sweep_orders[sweep_id] + object.first_cluster];
+
+    InstanceTransform instance = instances[object_id];
+    vec4 center = instance.transform * cluster.center + instance.translation;
+    float radius = cluster.radius * get_scale(instance.transform);
+    if (abs(dot(u_hyperplane_normal, center) + u_hyperplane_displacement) > radius + 0.0001)
+    {
+        return;
+    }
+
+    // Reserve space for this cluster's tetrahedra, and make sure that the second pass covers all of them
+    uint first = atomicAdd(dispatch.count, cluster.number_of_tetrahedra);
+    atomicMax(dispatch.number_of_groups_x, (first + cluster.number_of_tetrahedra + 127) / 128);
+
+    for (uint i = 0; i < cluster.number_of_tetrahedra; ++i)
+    {
+        active_tetrahedra[first + i] = uvec2(object_id, object.first_tetrahedron + cluster.first_tetrahedron + i);
+    }
+}
@@ -2,206 +2,196 @@
 
 layout(local_size_x = 128, local_size_y = 1, local_size_z = 1) in;
 
-uniform vec4 u_hyperplane_normal;
-uniform float u_hyperplane_displacement;
+struct DrawElementsCommand
+{
+    uint count;
+    uint instance_count;
+    uint first_index;
+    uint base_vertex;
+    uint base_instance;
+};
 
-uniform mat4 u_transform;
-uniform vec4 u_translation;
-uniform float u_time;
+// This must match `Renderer::DispatchCommand`
+struct DispatchCommand
+{
+    uint number_of_groups_x;
+    uint number_of_groups_y;
+    uint number_of_groups_z;
+    uint count;
+};
 
-uniform int u_object_index;
+// This must match `Renderer::ObjectDescriptor`
+struct ObjectDescriptor
+{
+    uint first_vertex;
+    uint first_instance_vertex;
+    uint first_slice_edge;
+    uint first_instance_slice_edge;
+    uint first_tetrahedron;
+    uint first_instance_tetrahedron;
+    uint first_cell;
+    uint first_instance_cell;
+    uint first_cell_slice_vertex;
+    uint flip_winding;
+    uint slice_cells;
+    uint first_cluster;
+    uint first_active_cluster;
+    uint first_sweep_cluster;
+    uint first_visible_vertex;
+    uint first_visible_slice_edge;
+    uint first_visible_cell;
+};
 
-struct Tetrahedron
+// Read only: the (mesh-local) indices of the 6 unique edges of each tetrahedron, in the order (0, 1), (0, 2), (0, 3), 
+// (1, 2), (1, 3), (2, 3).
+layout(std430, binding = 0) readonly buffer BUFF_tetrahedra_edges
 {
-    vec4 vertices[4];
+    uint tetrahedra_edges[];
 };
 
-struct Slice
+// Write only: the triangles of the slice (as indices into the edge intersections, see `compute_slice_edges.glsl`), 
+// tightly packed (in no particular order).
+layout(std430, binding = 1) writeonly buffer BUFF_slice_indices
 {
-    vec4 vertices[6];
+    uint slice_indices[];
 };
 
-struct DrawCommand
+// Read + write: one draw command per object, whose `count` is used to allocate space in the object's range of the
+// buffers above and below (it must be reset to 0 before each dispatch).
+layout(std430, binding = 2) buffer BUFF_indirect
 {
-    uint count;
-    uint instance_count;
-    uint first;
-    uint base_instance;
+    DrawElementsCommand indirect[];
 };
 
-// Read only.
-layout(std430, binding = 0) readonly buffer BUFF_tetrahedra
+// Write only: the tetrahedron that produced each slice triangle, which `projections.frag` uses to look up the
+// triangle's color (since vertices are shared between tetrahedra, and hence, cells).
+layout(std430, binding = 3) writeonly buffer BUFF_slice_primitives
 {
-    Tetrahedron tetrahedra[];
+    uint slice_primitives[];
 };
 
-// Read + write.
-layout(std430, binding = 1) buffer BUFF_slice_vertices
+// Read only: the (mesh-local) indices of the 4 vertices of each tetrahedron.
+layout(std430, binding = 4) readonly buffer BUFF_simplices
 {
-    Slice slice_vertices[];
+    uvec4 simplices[];
 };
 
-// Write only.
-layout(std430, binding = 2) writeonly buffer BUFF_indirect
+// Read only: the signed distance between each of the (transformed) vertices and the hyperplane.
+layout(std430, binding = 5) readonly buffer BUFF_distances
 {
-    DrawCommand indirect[];
+    float distances[];
 };
 
-// Determined the signed distance between `point` and the hyperplane.
-float side(in vec4 point)
+// Read only: the ranges of each of the shared buffers that belong to each object.
+layout(std430, binding = 6) readonly buffer BUFF_objects
 {
-    return dot(u_hyperplane_normal, point) + u_hyperplane_displacement;
-}
+    ObjectDescriptor objects[];
+};
 
-// Clamp `value` between -1..1.
-float saturate(float value)
+// Read only: the tetrahedra that survived cluster culling (see `compute_cull_clusters.glsl`), as pairs of object and
+// tetrahedron indices.
+layout(std430, binding = 7) readonly buffer BUFF_active_tetrahedra
 {
-    return min(1.0, max(-1.0, value));
-}
+    uvec2 active_tetrahedra[];
+};
 
-void main()
+// Read only: the indirect dispatch that launched this pass, whose `count` is the number of active tetrahedra.
+layout(std430, binding = 8) readonly buffer BUFF_dispatch
 {
-    const uvec2 edge_indices[] =
-    {
-        { 0, 1 },
-        { 0, 2 },
-        { 0, 3 },
-        { 1, 2 },
-        { 1, 3 },
-        { 2, 3 }
-    };
-
-    const uint max_intersections = 4;
-    const uint max_new_vertices = 6;
-    const uint ignore = 6;
-
-    // Grab the appropriate tetrahedron based on this invocations local ID
-    uint local_id = gl_GlobalInvocationID.x;
-    uint slice_id = 0;
-    vec3 slice_centroid = vec3(0.0);
-    Tetrahedron tetra = tetrahedra[local_id];
-
-    // This array will be filled out with up to 4 unique points of intersection in the for-loop below
-    vec4 intersections[4] =
-    {
-        vec4(0.0),
-        vec4(0.0),
-        vec4(0.0),
-        vec4(0.0)
-    };
-
-    // Loop through all of this tetrahedron's edges
-    for (uint i = 0; i < edge_indices.length(); ++i)
-    {
-        uvec2 edge = edge_indices[i];
-        vec4 a = u_transform * tetra.vertices[edge.x];
-        vec4 b = u_transform * tetra.vertices[edge.y];
+    DispatchCommand dispatch;
+};
 
-        a += u_translation;
-        b += u_translation;
+// The number of slice vertices produced by each of the 16 possible cases, where bit `i` of the case index is 
+// set if vertex `i` of the tetrahedron lies on the positive side of the hyperplane: either nothing, a triangle 
+// (1 or 3 vertices on the positive side), or a quad (2 vertices on either side).
+const uint case_counts[16] = { 0, 3, 3, 4, 3, 4, 4, 3, 3, 4, 4, 3, 4, 3, 3, 0 };
+
+// The local indices (see `tetrahedra_edges` above) of the edges that are intersected in each of the 16 cases, in 
+// order around the resulting polygon. Each case is the reverse of its complement, so all of the polygons are wound 
+// the same way with respect to the hyperplane normal. For a tetrahedron that is positively oriented with respect 
+// to its hull normal (see `Renderer::add_tetrahedra(...)`), this means that they are wound counter-clockwise when
+// seen from outside of the polychoron (unless the object's `flip_winding` is set).
+const uvec4 case_edges[16] =
+{
+    uvec4(0, 0, 0, 0),
+    uvec4(0, 1, 2, 0),
+    uvec4(0, 4, 3, 0),
+    uvec4(2, 4, 3, 1),
+    uvec4(1, 3, 5, 0),
+    uvec4(0, 3, 5, 2),
+    uvec4(0, 4, 5, 1),
+    uvec4(4, 5, 2, 0),
+    uvec4(2, 5, 4, 0),
+    uvec4(1, 5, 4, 0),
+    uvec4(2, 5, 3, 0),
+    uvec4(5, 3, 1, 0),
+    uvec4(1, 3, 4, 2),
+    uvec4(3, 4, 0, 0),
+    uvec4(2, 1, 0, 0),
+    uvec4(0, 0, 0, 0)
+};
 
-        float t = -side(a) / (side(b) - side(a));
+// This is the second of two passes: each active tetrahedron (i.e. one whose cluster can possibly intersect the
+// hyperplane) classifies its vertices against the hyperplane and emits 
+// triangles (as a fan around the first polygon vertex) that refer to the intersections computed in the first 
+// pass by edge index.
+void main()
+{
+    // Grab the appropriate tetrahedron (of the appropriate object) based on this invocations global ID: objects 
+    // whose cells are sliced directly have no active tetrahedra, since they are handled by `compute_slice_cells.glsl`
+    uint active_id = gl_GlobalInvocationID.x;
+    if (active_id >= dispatch.count)
+    {
+        return;
+    }
 
-        if (t >= 0.0 && t <= 1.0)
-        {
-            // Calculate and store the point of intersection
-            vec4 intersection = a + (b - a) * t;
-            intersections[slice_id] = intersection;
+    uint object_id = active_tetrahedra[active_id].x;
+    ObjectDescriptor object = objects[object_id];
+    uint local_id = active_tetrahedra[active_id].y;
 
-            slice_centroid += intersection.xyz;
-            slice_id++;
-        }
-    }
-    slice_centroid /= float(slice_id);
+    // Build the 4-bit case index from the cached distances of this tetrahedron's vertices: an edge is intersected
+    // exactly when its endpoints fall on different sides (matching the crossing test in the first pass)
+    uvec4 simplex = simplices[local_id] + object.first_instance_vertex;
+    vec4 sides = vec4(distances[simplex.x], distances[simplex.y], distances[simplex.z], distances[simplex.w]);
+    uvec4 bits = uvec4(greaterThan(sides, vec4(0.0))) << uvec4(0, 1, 2, 3);
+    uint mask = bits.x | bits.y | bits.z | bits.w;
 
-    // The variable `slice_id` is an integer corresponding to the number of valid
-    // intersections that were found: realistically, this should ONLY ever be
-    // 0, 3, or 4
-    if (slice_id == 0) // Empty intersection (0-count draw call)
+    // Most tetrahedra lie entirely on one side of the hyperplane and produce no output at all
+    uint count = case_counts[mask];
+    if (count == 0)
     {
-        indirect[local_id] = DrawCommand(0, 0, local_id * max_new_vertices, 0);
+        return;
     }
-    else if (slice_id == 3) // Tri
-    {
-        slice_vertices[local_id].vertices[0] = intersections[0];
-        slice_vertices[local_id].vertices[1] = intersections[1];
-        slice_vertices[local_id].vertices[2] = intersections[2];
 
-        // 3, 4, 5 are ignored...
-        indirect[local_id] = DrawCommand(3, 1, local_id * max_new_vertices, 0);
-    }
-    else if (slice_id == 4) // Quad
+    uvec4 local_edges = case_edges[mask];
+    uvec4 polygon = uvec4(
+        tetrahedra_edges[local_id * 6 + local_edges.x],
+        tetrahedra_edges[local_id * 6 + local_edges.y],
+        tetrahedra_edges[local_id * 6 + local_edges.z],
+        tetrahedra_edges[local_id * 6 + local_edges.w]
+    ) + object.first_instance_slice_edge;
+
+    if (object.flip_winding != 0)
     {
-        // We have to use `vec2`s here instead of `uvec2`s because the signed angles
-        // will be floating-point values
-        vec2 angles[max_intersections] =
-        {
-            { 0.0, 0.0 },
-            { 1.0, 0.0 },
-            { 2.0, 0.0 },
-            { 3.0, 0.0 }
-        };
-
-        // Compute the slice normal (in 3-dimensions)
-        vec3 a = intersections[0].xyz;
-        vec3 b = intersections[1].xyz;
-        vec3 c = intersections[2].xyz;
-        vec3 ab = b - a;
-        vec3 bc = c - b;
-        vec3 n = normalize(cross(bc, ab));
-
-        // TODO: determine outward facing normal `https://www.gamedev.net/forums/topic/433315-determining-outward-facing-normals/?do=findComment&comment=3880903`
-        // TODO: sorting the points in 3D seems to work, but why?
-
-        vec3 first_edge = normalize(a - slice_centroid);
-
-        for (int i = 1; i < angles.length(); ++i)
-        {
-            vec3 p = intersections[i].xyz;
-            vec3 edge = normalize(p - slice_centroid);
-
-            float angle = saturate(dot(first_edge, edge));
-            float signed_angle = acos(angle);
-
-            if (dot(n, cross(first_edge, edge)) < 0.0)
-            {
-                signed_angle *= -1.0;
-            }
-
-            angles[i].y = signed_angle;
-        }
-
-        // Perform an insertion sort
-        uint i = 1;
-        while(i < angles.length())
-        {
-            uint j = i;
-            while(j > 0 && (angles[j - 1].y > angles[j].y))
-            {
-                vec2 temp = angles[j];
-                angles[j] = angles[j - 1];
-                angles[j - 1] = temp;
-
-                j--;
-            }
-            i++;
-        }
-
-        // First triangle...(0, 1, 2)
-        slice_vertices[local_id].vertices[0] = intersections[uint(angles[0].x)];
-        slice_vertices[local_id].vertices[1] = intersections[uint(angles[1].x)];
-        slice_vertices[local_id].vertices[2] = intersections[uint(angles[2].x)];
-
-        // First triangle...(0, 2, 3)
-        slice_vertices[local_id].vertices[3] = intersections[uint(angles[0].x)];
-        slice_vertices[local_id].vertices[4] = intersections[uint(angles[2].x)];
-        slice_vertices[local_id].vertices[5] = intersections[uint(angles[3].x)];
-
-        indirect[local_id] = DrawCommand(max_new_vertices, 1, local_id * max_new_vertices, 0);
+        polygon = (count == 3) ? polygon.xzyw : polygon.xwzy;
     }
-    else
+
+    // Reserve space for 1 (tri) or 2 (quad) triangles at the end of this object's range of the output buffers
+    uint number_of_indices = (count - 2) * 3;
+    uint first = object.first_instance_tetrahedron * 6 + atomicAdd(indirect[object_id].count, number_of_indices);
+
+    // First triangle...(0, 1, 2)
+    slice_indices[first + 0] = polygon.x;
+    slice_indices[first + 1] = polygon.y;
+    slice_indices[first + 2] = polygon.z;
+    slice_primitives[first / 3] = local_id;
+
+    // Second triangle...(0, 2, 3)
+    if (count == 4)
     {
-        // We should never get here...
-        indirect[local_id] = DrawCommand(0, 0, local_id * max_new_vertices, 0);
+        slice_indices[first + 3] = polygon.x;
+        slice_indices[first + 4] = polygon.z;
+        slice_indices[first + 5] = polygon.w;
+        slice_primitives[first / 3 + 1] = local_id;
     }
 }
@@ -0,0 +1,243 @@
+#version 450
+
+layout(local_size_x = 128, local_size_y = 1, local_size_z = 1) in;
+
+uniform vec4 u_hyperplane_normal;
+uniform int u_number_of_cells;
+uniform int u_number_of_objects;
+
+// This must match `Renderer::max_polygon_vertices`
+#define MAX_POLYGON_VERTICES 64
+
+struct DrawCommand
+{
+    uint count;
+    uint instance_count;
+    uint first;
+    uint base_instance;
+};
+
+// This must match `Renderer::ObjectDescriptor`
+struct ObjectDescriptor
+{
+    uint first_vertex;
+    uint first_instance_vertex;
+    uint first_slice_edge;
+    uint first_instance_slice_edge;
+    uint first_tetrahedron;
+    uint first_instance_tetrahedron;
+    uint first_cell;
+    uint first_instance_cell;
+    uint first_cell_slice_vertex;
+    uint flip_winding;
+    uint slice_cells;
+    uint first_cluster;
+    uint first_active_cluster;
+    uint first_sweep_cluster;
+    uint first_visible_vertex;
+    uint first_visible_slice_edge;
+    uint first_visible_cell;
+};
+
+// This must match `Renderer::InstanceTransform`
+struct InstanceTransform
+{
+    mat4 transform;
+    vec4 translation;
+};
+
+// Read only: the unique vertices of each object, after they have been transformed (see `compute_transform.glsl`).
+layout(std430, binding = 0) readonly buffer BUFF_vertices
+{
+    vec4 vertices[];
+};
+
+// Read only: cell `i` owns the edges `cell_ranges[i].x` up to (but not including) `cell_ranges[i].x + cell_ranges[i].y`.
+layout(std430, binding = 1) readonly buffer BUFF_cell_ranges
+{
+    uvec2 cell_ranges[];
+};
+
+// Read only: pairs of (mesh-local) vertex indices.
+layout(std430, binding = 2) readonly buffer BUFF_cell_edges
+{
+    uvec2 cell_edges[];
+};
+
+// Write only: the triangles of the slice, tightly packed (in no particular order).
+layout(std430, binding = 3) writeonly buffer BUFF_slice_vertices
+{
+    vec4 slice_vertices[];
+};
+
+// Read + write: one draw command per object, whose `count` is used to allocate space in the object's range of the
+// buffers above and below (it must be reset to 0 before each dispatch).
+layout(std430, binding = 4) buffer BUFF_indirect
+{
+    DrawCommand indirect[];
+};
+
+// Read only: the outward-facing hull normal of each cell.
+layout(std430, binding = 5) readonly buffer BUFF_cell_normals
+{
+    vec4 cell_normals[];
+};
+
+// Write only: the tetrahedron that each slice triangle is colored by (see `projections.frag`).
+layout(std430, binding = 6) writeonly buffer BUFF_slice_primitives
+{
+    uint slice_primitives[];
+};
+
+// Read only: the signed distance between each of the transformed vertices and the hyperplane.
+layout(std430, binding = 7) readonly buffer BUFF_distances
+{
+    float distances[];
+};
+
+// Read only: the ranges of each of the shared buffers that belong to each object.
+layout(std430, binding = 8) readonly buffer BUFF_objects
+{
+    ObjectDescriptor objects[];
+};
+
+// Read only: the transform of each object.
+layout(std430, binding = 9) readonly buffer BUFF_instances
+{
+    InstanceTransform instances[];
+};
+
+// Read only: one (any) of the tetrahedra of each cell, which shares the cell's hull normal and hence, its color.
+layout(std430, binding = 10) readonly buffer BUFF_cell_tetrahedra
+{
+    uint cell_tetrahedra[];
+};
+
+// Returns the index of the object that owns visible cell `id`, via a binary search over the (sorted) ranges of 
+// all of the objects.
+uint find_object(uint id)
+{
+    uint low = 0;
+    uint high = uint(u_number_of_objects) - 1;
+    while (low < high)
+    {
+        uint middle = (low + high + 1) / 2;
+        if (objects[middle].first_visible_cell <= id)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    return low;
+}
+
+void main()
+{
+    // Only objects whose cells are sliced directly (and that weren't culled) have any visible cells
+    uint visible_id = gl_GlobalInvocationID.x;
+    if (visible_id >= uint(u_number_of_cells))
+    {
+        return;
+    }
+
+    uint object_id = find_object(visible_id);
+    ObjectDescriptor object = objects[object_id];
+    uint cell_id = visible_id - object.first_visible_cell + object.first_cell;
+
+    // A convex cell intersects the hyperplane in a single convex polygon, whose vertices are the
+    // points where the cell's edges cross the hyperplane
+    vec4 intersections[MAX_POLYGON_VERTICES];
+    float angles[MAX_POLYGON_VERTICES];
+    uint count = 0;
+    vec3 centroid = vec3(0.0);
+
+    uvec2 range = cell_ranges[cell_id];
+    for (uint i = range.x; i < range.x + range.y && count < MAX_POLYGON_VERTICES; ++i)
+    {
+        uvec2 edge = cell_edges[i] + object.first_instance_vertex;
+        float side_a = distances[edge.x];
+        float side_b = distances[edge.y];
+
+        if ((side_a < 0.0) != (side_b < 0.0))
+        {
+            vec4 a = vertices[edge.x];
+            vec4 b = vertices[edge.y];
+            float t = -side_a / (side_b - side_a);
+            intersections[count] = a + (b - a) * t;
+            centroid += intersections[count].xyz;
+            count++;
+        }
+    }
+
+    if (count < 3)
+    {
+        return;
+    }
+    centroid /= float(count);
+
+    // Find the normal of the polygon (in 3-dimensions): use the vertex that is furthest from being
+    // parallel to the first one, so that this is well-defined for any (non-degenerate) polygon
+    vec3 u = intersections[0].xyz - centroid;
+    vec3 n = vec3(0.0);
+    for (uint i = 1; i < count; ++i)
+    {
+        vec3 candidate = cross(u, intersections[i].xyz - centroid);
+        if (dot(candidate, candidate) > dot(n, n))
+        {
+            n = candidate;
+        }
+    }
+    u = normalize(u);
+    n = normalize(n);
+
+    // Make sure that the polygon faces outwards: the cell's hull normal, projected into the hyperplane, points away 
+    // from the slice (and so does its 4D -> 3D projection)
+    vec4 outward = instances[object_id].transform * cell_normals[cell_id];
+    outward -= dot(outward, u_hyperplane_normal) * u_hyperplane_normal;
+    if (dot(n, outward.xyz) < 0.0)
+    {
+        n = -n;
+    }
+    vec3 v = cross(n, u);
+
+    // Sort the vertices by their angle around the centroid (insertion sort)
+    for (uint i = 0; i < count; ++i)
+    {
+        vec3 p = intersections[i].xyz - centroid;
+        angles[i] = atan(dot(p, v), dot(p, u));
+    }
+    for (uint i = 1; i < count; ++i)
+    {
+        uint j = i;
+        while (j > 0 && angles[j - 1] > angles[j])
+        {
+            float temp_angle = angles[j];
+            angles[j] = angles[j - 1];
+            angles[j - 1] = temp_angle;
+
+            vec4 temp_intersection = intersections[j];
+            intersections[j] = intersections[j - 1];
+            intersections[j - 1] = temp_intersection;
+
+            j--;
+        }
+    }
+
+    // Reserve space for the polygon's triangles at the end of this object's range of the output buffers, then 
+    // emit it as a fan of triangles around its first vertex
+    const uint first = object.first_cell_slice_vertex + atomicAdd(indirect[object_id].count, (count - 2) * 3);
+    const uint tetrahedron = cell_tetrahedra[cell_id];
+    for (uint i = 0; i < count - 2; ++i)
+    {
+        slice_vertices[first + i * 3 + 0] = intersections[0];
+        slice_vertices[first + i * 3 + 1] = intersections[i + 1];
+        slice_vertices[first + i * 3 + 2] = intersections[i + 2];
+    }
+    for (uint i = 0; i < count - 2; ++i)
+    {
+        slice_primitives[first / 3 + i] = tetrahedron;
+    }
+}
\ No newline at end of file
@@ -0,0 +1,125 @@
+#version 450
+
+layout(local_size_x = 128, local_size_y = 1, local_size_z = 1) in;
+
+uniform int u_number_of_edges;
+uniform int u_number_of_objects;
+
+// Whether or not the edge intersections are stored in the compact layout (see `Renderer::VertexFormat`)
+uniform bool u_compact;
+
+// This must match `Renderer::ObjectDescriptor`
+struct ObjectDescriptor
+{
+    uint first_vertex;
+    uint first_instance_vertex;
+    uint first_slice_edge;
+    uint first_instance_slice_edge;
+    uint first_tetrahedron;
+    uint first_instance_tetrahedron;
+    uint first_cell;
+    uint first_instance_cell;
+    uint first_cell_slice_vertex;
+    uint flip_winding;
+    uint slice_cells;
+    uint first_cluster;
+    uint first_active_cluster;
+    uint first_sweep_cluster;
+    uint first_visible_vertex;
+    uint first_visible_slice_edge;
+    uint first_visible_cell;
+};
+
+// Read only: the unique vertices of each object, after they have been transformed (see `compute_transform.glsl`).
+layout(std430, binding = 0) readonly buffer BUFF_vertices
+{
+    vec4 vertices[];
+};
+
+// Read only: the unique edges of each tetrahedral mesh, as pairs of (mesh-local) vertex indices.
+layout(std430, binding = 1) readonly buffer BUFF_edges
+{
+    uvec2 edges[];
+};
+
+// Write only: the point where each edge crosses the hyperplane (if it does: otherwise, the entry is left untouched, 
+// and it will never be referenced by the second pass).
+layout(std430, binding = 2) writeonly buffer BUFF_edge_intersections
+{
+    uint edge_intersections[];
+};
+
+// Read only: the signed distance between each of the transformed vertices and the hyperplane.
+layout(std430, binding = 3) readonly buffer BUFF_distances
+{
+    float distances[];
+};
+
+// Read only: the ranges of each of the shared buffers that belong to each object.
+layout(std430, binding = 4) readonly buffer BUFF_objects
+{
+    ObjectDescriptor objects[];
+};
+
+// Returns the index of the object that owns visible edge `id`, via a binary search over the (sorted) ranges of 
+// all of the objects.
+uint find_object(uint id)
+{
+    uint low = 0;
+    uint high = uint(u_number_of_objects) - 1;
+    while (low < high)
+    {
+        uint middle = (low + high + 1) / 2;
+        if (objects[middle].first_visible_slice_edge <= id)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    return low;
+}
+
+// This is the first of two passes: each edge is intersected with the hyperplane exactly once here, no
+// matter how many tetrahedra share it, and the second pass (`compute_slice.glsl`) simply refers to the
+// resulting points by edge index.
+void main()
+{
+    uint visible_id = gl_GlobalInvocationID.x;
+    if (visible_id >= uint(u_number_of_edges))
+    {
+        return;
+    }
+
+    uint object_id = find_object(visible_id);
+    uint local_id = visible_id - objects[object_id].first_visible_slice_edge;
+    uint edge_id = objects[object_id].first_instance_slice_edge + local_id;
+    uvec2 edge = edges[objects[object_id].first_slice_edge + local_id] + objects[object_id].first_instance_vertex;
+    float side_a = distances[edge.x];
+    float side_b = distances[edge.y];
+    float t = -side_a / (side_b - side_a);
+
+    if (t >= 0.0 && t <= 1.0)
+    {
+        vec4 a = vertices[edge.x];
+        vec4 b = vertices[edge.y];
+        vec4 intersection = a + (b - a) * t;
+
+        // Each point is stored either as a `vec4` (4 words) or as 4 half floats (2 words)
+        if (u_compact)
+        {
+            edge_intersections[edge_id * 2 + 0] = packHalf2x16(intersection.xy);
+            edge_intersections[edge_id * 2 + 1] = packHalf2x16(intersection.zw);
+        }
+        else
+        {
+            uvec4 bits = floatBitsToUint(intersection);
+            edge_intersections[edge_id * 4 + 0] = bits.x;
+            edge_intersections[edge_id * 4 + 1] = bits.y;
+            edge_intersections[edge_id * 4 + 2] = bits.z;
+            edge_intersections[edge_id * 4 + 3] = bits.w;
+        }
+    }
+}
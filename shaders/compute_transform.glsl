@@ -0,0 +1,143 @@
+#version 450
+
+layout(local_size_x = 128, local_size_y = 1, local_size_z = 1) in;
+
+uniform vec4 u_hyperplane_normal;
+uniform float u_hyperplane_displacement;
+
+uniform int u_number_of_vertices;
+uniform int u_number_of_objects;
+
+// Whether or not the vertices are stored in the compact layout (see `Renderer::VertexFormat`)
+uniform bool u_compact;
+
+// Whether or not the vertices need to be transformed: if not, the transformed vertices from the previous slice are
+// still valid (none of the objects have moved), and only their distances to the hyperplane are updated.
+uniform bool u_transform;
+
+// This must match `Renderer::ObjectDescriptor`
+struct ObjectDescriptor
+{
+    uint first_vertex;
+    uint first_instance_vertex;
+    uint first_slice_edge;
+    uint first_instance_slice_edge;
+    uint first_tetrahedron;
+    uint first_instance_tetrahedron;
+    uint first_cell;
+    uint first_instance_cell;
+    uint first_cell_slice_vertex;
+    uint flip_winding;
+    uint slice_cells;
+    uint first_cluster;
+    uint first_active_cluster;
+    uint first_sweep_cluster;
+    uint first_visible_vertex;
+    uint first_visible_slice_edge;
+    uint first_visible_cell;
+};
+
+// This must match `Renderer::InstanceTransform`
+struct InstanceTransform
+{
+    mat4 transform;
+    vec4 translation;
+};
+
+// Read only: the unique vertices of all of the meshes, either as `vec4`s (4 words each) or as 4 16-bit snorms 
+// (2 words each), see `get_vertex(...)`.
+layout(std430, binding = 0) readonly buffer BUFF_vertices
+{
+    uint vertices[];
+};
+
+// Read + write: the unique vertices of each object, after they have been rotated and translated.
+layout(std430, binding = 1) buffer BUFF_transformed_vertices
+{
+    vec4 transformed_vertices[];
+};
+
+// Write only: the signed distance between each of the transformed vertices and the hyperplane.
+layout(std430, binding = 2) writeonly buffer BUFF_distances
+{
+    float distances[];
+};
+
+// Read only: the ranges of each of the shared buffers that belong to each object.
+layout(std430, binding = 3) readonly buffer BUFF_objects
+{
+    ObjectDescriptor objects[];
+};
+
+// Read only: the transform of each object.
+layout(std430, binding = 4) readonly buffer BUFF_instances
+{
+    InstanceTransform instances[];
+};
+
+// Returns the index of the object that owns visible vertex `id`, via a binary search over the (sorted) ranges of 
+// all of the objects.
+uint find_object(uint id)
+{
+    uint low = 0;
+    uint high = uint(u_number_of_objects) - 1;
+    while (low < high)
+    {
+        uint middle = (low + high + 1) / 2;
+        if (objects[middle].first_visible_vertex <= id)
+        {
+            low = middle;
+        }
+        else
+        {
+            high = middle - 1;
+        }
+    }
+    return low;
+}
+
+// Decodes the vertex at `index` (in either layout).
+vec4 get_vertex(uint index)
+{
+    if (u_compact)
+    {
+        return vec4(unpackSnorm2x16(vertices[index * 2 + 0]), unpackSnorm2x16(vertices[index * 2 + 1]));
+    }
+    return uintBitsToFloat(uvec4(vertices[index * 4 + 0], vertices[index * 4 + 1], vertices[index * 4 + 2], vertices[index * 4 + 3]));
+}
+
+// Determined the signed distance between `point` and the hyperplane.
+float side(in vec4 point)
+{
+    return dot(u_hyperplane_normal, point) + u_hyperplane_displacement;
+}
+
+// This runs before any of the slicing passes, so that each vertex is only transformed once (rather than once
+// per edge or tetrahedron that it belongs to).
+void main()
+{
+    uint visible_id = gl_GlobalInvocationID.x;
+    if (visible_id >= uint(u_number_of_vertices))
+    {
+        return;
+    }
+
+    // Each object (i.e. instance of a mesh) transforms its own copy of the mesh's vertices (unless it was culled)
+    uint object_id = find_object(visible_id);
+    uint local_id = visible_id - objects[object_id].first_visible_vertex;
+    uint vertex_id = objects[object_id].first_instance_vertex + local_id;
+
+    vec4 transformed;
+    if (u_transform)
+    {
+        InstanceTransform instance = instances[object_id];
+        transformed = instance.transform * get_vertex(objects[object_id].first_vertex + local_id) + instance.translation;
+        transformed_vertices[vertex_id] = transformed;
+    }
+    else
+    {
+        transformed = transformed_vertices[vertex_id];
+    }
+
+    distances[vertex_id] = side(transformed);
+}
@@ -1,14 +1,50 @@
-#version 450
+#version 460
 
 in VS_OUT 
 {
     vec4 color;
     vec3 position;
+    flat uint first_primitive;
 } fs_in;
 
 layout(location = 0) out vec4 o_color;
 
+uniform bool u_primitive_colors = false;
+
+// Whether or not the normals below are stored in the compact layout (see `Renderer::VertexFormat`)
+uniform bool u_compact = false;
+
+// Read only: the tetrahedron that produced each primitive, whose color is used instead of the vertex colors when
+// `u_primitive_colors` is set (slice vertices are shared between tetrahedra, and hence, between differently colored cells).
+layout(std430, binding = 0) readonly buffer BUFF_primitive_tetrahedra
+{
+    uint primitive_tetrahedra[];
+};
+
+// Read only: the hyperplane normal of each tetrahedron: either as a `vec4` (4 words) or as 4 8-bit snorms (a single
+// word), see `get_normal(...)`.
+layout(std430, binding = 2) readonly buffer BUFF_normals
+{
+    uint normals[];
+};
+
+// Decodes the normal of the tetrahedron at `index` (in either layout).
+vec4 get_normal(uint index)
+{
+    if (u_compact)
+    {
+        return unpackSnorm4x8(normals[index]);
+    }
+    return uintBitsToFloat(uvec4(normals[index * 4 + 0], normals[index * 4 + 1], normals[index * 4 + 2], normals[index * 4 + 3]));
+}
+
 void main()
 {
     o_color = fs_in.color;
+
+    if (u_primitive_colors)
+    {
+        // This matches the orthographic coloring in the vertex shader
+        o_color.rgb = normalize(get_normal(primitive_tetrahedra[fs_in.first_primitive + gl_PrimitiveID]).rgb) * 0.5 + 0.5;
+    }
 }
\ No newline at end of file
@@ -1,4 +1,4 @@
-#version 450
+#version 460
 
 #define pi 3.1415926535897932384626433832795
 
@@ -8,8 +8,6 @@ uniform float u_time;
 // be the last column of this transformation matrix)
 uniform vec4 u_four_from;
 
-uniform vec4 u_four_model_translation;
-uniform mat4 u_four_model_orientation;
 uniform mat4 u_four_view;
 uniform mat4 u_four_projection;
 
@@ -22,6 +20,20 @@ uniform bool u_perspective_3D = true;
 
 uniform float u_clip_distance_w = 0.0;
 
+// This must match `Renderer::InstanceTransform`
+struct InstanceTransform
+{
+    mat4 transform;
+    vec4 translation;
+};
+
+// Read only: the 4D transform of each object, which is indexed by `gl_BaseInstance` when drawing skeletons (slices
+// are already transformed by the compute shaders).
+layout(std430, binding = 1) readonly buffer BUFF_instances
+{
+    InstanceTransform instances[];
+};
+
 layout(location = 0) in vec4 i_position;
 layout(location = 1) in vec4 i_color;
 
@@ -29,6 +41,7 @@ out VS_OUT
 {
     vec4 color;
     vec3 position;
+    flat uint first_primitive;
 } vs_out;
 
 // https://github.com/hughsk/glsl-hsv2rgb/blob/master/index.glsl
@@ -80,8 +93,9 @@ void main()
     // Project 4D -> 3D with a perspective projection
     if (u_perspective_4D)
     {
-        four = u_four_model_orientation * i_position;
-        four = four + u_four_model_translation;
+        InstanceTransform instance = instances[gl_BaseInstance + gl_InstanceID];
+        four = instance.transform * i_position;
+        four = four + instance.translation;
         four = four - u_four_from;
         four = u_four_view * four;
         four = u_four_projection * four;
@@ -127,4 +141,8 @@ void main()
     // Pass values to fragment shader
     vs_out.color = vec4(color, alpha);
     vs_out.position = three.xyz;
+
+    // Slices of all objects share a single buffer of per-primitive colors, and each (indirect) draw command
+    // stores the index of its object's first triangle in `base_instance`
+    vs_out.first_primitive = gl_BaseInstance;
 }
\ No newline at end of file
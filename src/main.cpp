@@ -1,6 +1,5 @@
 #include <algorithm>
 #include <iostream>
-#include <map>
 
 #include "glad/glad.h"
 #include "GLFW/glfw3.h"
@@ -9,16 +8,17 @@
 #include "imgui.h"
 #include "imgui_impl_glfw.h"
 #include "imgui_impl_opengl3.h"
-#include "libqhullcpp/RboxPoints.h"
-#include "libqhullcpp/Qhull.h"
-#include "libqhullcpp/QhullFacetList.h"
-#include "libqhullcpp/QhullVertexSet.h"
 
 #include "camera.h"
+#include "hull.h"
+#include "loader.h"
+#include "mesh_cache.h"
 #include "maths.h"
 #include "polychora.h"
 #include "renderer.h"
+#include "rotor.h"
 #include "shader.h"
+#include "wythoff.h"
 
 // Data that will be associated with the GLFW window
 struct InputData
@@ -38,6 +38,7 @@ glm::mat4 arcball_model_matrix = glm::mat4{ 1.0f };
 
 // 4-dimensional rendering settings
 size_t polychoron_index = 0;
+size_t catalog_index = 0;
 float rotation_xy = 0.0f;
 float rotation_yz = 0.0f;
 float rotation_zx = 0.0f;
@@ -46,6 +47,8 @@ float rotation_yw = 0.0f;
 float rotation_zw = 0.0f;
 float clip_distance_w = 1.25f;
 bool display_wireframe = false;
+bool slice_cells = false;
+bool kinetic_slicing = true;
 const std::vector<std::string> modes = { "Slice", "Tetrahedra", "Edges" };
 std::string current_mode = modes[0];
 
@@ -263,9 +266,10 @@ void initialize()
         // Depth testing
         glEnable(GL_DEPTH_TEST);
 
-        // For now, we don't really know the winding order of the tetrahedron
-        // slices, so we want to disable face culling
-        glDisable(GL_CULL_FACE);
+        // Slice triangles are always wound counter-clockwise when seen from outside of the 
+        // polychoron (see `compute_slice.glsl`), so back faces can be culled
+        glEnable(GL_CULL_FACE);
+        glCullFace(GL_BACK);
 
         // Enable alpha blending
         glEnable(GL_BLEND);
@@ -279,208 +283,18 @@ void initialize()
     }
 }
 
-double round_nearest_tenth(double x) 
-{ 
-    return floor(x * 10.0 + 0.5) / 10.0;
-}
-
-glm::mat4 build_simple_rotation_matrix()
+four::maths::Rotor4 build_orientation()
 {
-    return four::maths::get_simple_rotation_matrix(four::maths::Plane::XY, rotation_xy) *
-        four::maths::get_simple_rotation_matrix(four::maths::Plane::YZ, rotation_yz) *
-        four::maths::get_simple_rotation_matrix(four::maths::Plane::ZX, rotation_zx) *
-        four::maths::get_simple_rotation_matrix(four::maths::Plane::XW, rotation_xw) *
-        four::maths::get_simple_rotation_matrix(four::maths::Plane::YW, rotation_yw) *
-        four::maths::get_simple_rotation_matrix(four::maths::Plane::ZW, rotation_zw);
+    // The orientation is kept as a rotor (rather than a matrix) so that it can be interpolated when the rotations are reset
+    return four::maths::Rotor4::from_plane(four::maths::Plane::XY, rotation_xy) *
+        four::maths::Rotor4::from_plane(four::maths::Plane::YZ, rotation_yz) *
+        four::maths::Rotor4::from_plane(four::maths::Plane::ZX, rotation_zx) *
+        four::maths::Rotor4::from_plane(four::maths::Plane::XW, rotation_xw) *
+        four::maths::Rotor4::from_plane(four::maths::Plane::YW, rotation_yw) *
+        four::maths::Rotor4::from_plane(four::maths::Plane::ZW, rotation_zw);
 }
 
 
-std::vector<four::Tetrahedra> run_qhull(bool find_edges = true)
-{
-    std::vector<std::vector<four::combinatorics::PermutationSeed<float>>> all_permutation_seeds = four::get_all_permutation_seeds();
-
-    std::vector<four::Tetrahedra> tetrahedra_groups;
-
-    for (const auto& seeds : all_permutation_seeds)
-    {
-        std::cout << "Loading new 4D object..." << std::endl;
-
-        auto permutations = four::combinatorics::generate<float>(seeds);
-        std::cout << "\t" << permutations.size() << " permutations found" << std::endl;
-
-        std::vector<double> coordinates;
-        for (const auto& permutation : permutations)
-        {
-            if (permutation.size() != 4)
-            {
-                throw std::runtime_error("Permutation does not have the correct number of dimensions");
-            }
-            coordinates.push_back(permutation[0]);
-            coordinates.push_back(permutation[1]);
-            coordinates.push_back(permutation[2]);
-            coordinates.push_back(permutation[3]);
-        }
-
-        // Initialize QHull
-        orgQhull::Qhull qhull;
-
-        std::vector<glm::vec4> vertices;
-        std::vector<uint32_t> simplices;
-        std::vector<uint32_t> edges;
-        std::vector<glm::vec4> normals;
-
-        try {
-            // Run QHull
-            const bool triangulate = true;
-            if (triangulate)
-            { 
-                qhull.runQhull("", 4, permutations.size(), coordinates.data(), "Qt"); 
-            }
-            else 
-            {
-                // Merge coplanar facets within an epsilon 
-                qhull.runQhull("", 4, permutations.size(), coordinates.data(), "C0.001"); 
-            }
-
-            // Process unique points that form the convex hull
-            for (const auto& point : qhull.points())
-            {
-                auto coords = point.coordinates();
-                assert(point.dimension() == 4);
-
-                vertices.push_back(glm::normalize(glm::vec4{ coords[0], coords[1], coords[2], coords[3] }));
-            }
-
-            // Process unique facets that form the convex hull
-            std::cout << "\t" << "Facet count: " << qhull.facetList().count() << std::endl;
-            for (auto& face : qhull.facetList())
-            {
-                if (!face.isSimplicial())
-                {
-                    throw std::runtime_error("Non-simplical face found");
-                }
-                for (const auto& vertex : face.vertices())
-                {
-                    simplices.push_back(vertex.point().id());
-                }
-
-                auto hyperplane = face.hyperplane();
-                auto center = face.getCenter();
-                auto normal = hyperplane.coordinates();
-                assert(hyperplane.dimension() == 4);
-
-                normals.push_back(glm::normalize(glm::vec4{
-                    round_nearest_tenth(normal[0]),
-                    round_nearest_tenth(normal[1]),
-                    round_nearest_tenth(normal[2]),
-                    round_nearest_tenth(normal[3])
-                }));
-            }
-
-            std::cout << "\t" << "Convex hull resulted in:" << std::endl;
-            std::cout << "\t - " << vertices.size() << " vertices" << std::endl;
-            std::cout << "\t - " << simplices.size() / 4 << " simplices" << std::endl;
-            std::cout << "\t - " << normals.size() << " hyperplane normals" << std::endl;
-
-            if (find_edges)
-            {
-                float smallest = std::numeric_limits<float>::max();
-                float largest = std::numeric_limits<float>::min();
-
-                // Form a data structure that maps each vertex to a list containing the distance from that vertex 
-                // to each of the other vertices in the convex hull
-                std::map<size_t, std::vector<float>> vertex_id_to_neighbor_distances;
-
-                for (size_t i = 0; i < vertices.size(); ++i)
-                {
-                    vertex_id_to_neighbor_distances[i].reserve(vertices.size());
-
-                    for (size_t j = 0; j < vertices.size(); ++j)
-                    {
-                        const float distance = glm::distance(vertices[i], vertices[j]);
-                        vertex_id_to_neighbor_distances[i].push_back(distance);
-
-                        if (i != j)
-                        {
-                            if (distance < smallest)
-                            {
-                                smallest = distance;
-                            }
-                            if (distance > largest)
-                            {
-                                largest = distance;
-                            }
-                        }
-                    }
-                }
-
-                std::cout << "\t" << "Smallest distance: " << smallest << std::endl;
-                std::cout << "\t" << "Largest distance: " << largest << std::endl;
-                std::cout << "\t" << "Ratio (smallest to largest): " << smallest / largest << std::endl;
-                std::map<uint32_t, std::vector<uint32_t>> vertex_id_to_neighbor_ids;
-
-                // How close the distance between a pair of vertices must be (compared to the minimum distance calculated above)
-                // in order to be considered a "true" edge
-                const float edge_threshold = 0.065f;
-
-                for (const auto& [id, neighbor_distances] : vertex_id_to_neighbor_distances)
-                {
-                    for (size_t neighbor_id = 0; neighbor_id < neighbor_distances.size(); ++neighbor_id)
-                    {
-                        if (id != neighbor_id && abs(neighbor_distances[neighbor_id] - smallest) <= edge_threshold)
-                        {
-                            // There exists an edge between `id` and `neighbor_id` 
-                            vertex_id_to_neighbor_ids[id].push_back(neighbor_id);
-                        }
-                    }
-                }
-
-                // Custom set compare lambda function to avoid duplicate edges, i.e. <0, 1> and <1, 0> should be considered the same
-                //
-                // Reference: https://stackoverflow.com/questions/51013008/how-to-add-distinct-pairs-into-a-set
-                auto compare = [](std::pair<uint32_t, uint32_t> lhs, std::pair<uint32_t, uint32_t> rhs) 
-                {
-                    if (lhs.first > lhs.second) lhs = std::pair<uint32_t, uint32_t>{ lhs.second, lhs.first };
-                    if (rhs.first > rhs.second) rhs = std::pair<uint32_t, uint32_t>{ rhs.second, rhs.first };
-                    return lhs < rhs;
-                };
-                std::set<std::pair<uint32_t, uint32_t>, decltype(compare)> unique_edges(compare);
-
-                // Insert all pairs of vertex IDs into the set: duplicates will be ignored, per the comparison operator above
-                for (const auto& [id, neighbor_ids] : vertex_id_to_neighbor_ids)
-                {
-                    for (const auto& neighbor_id : neighbor_ids)
-                    {
-                        unique_edges.insert({ id, neighbor_id });
-                    }
-                }
-                std::cout << "\t" << "Found " << unique_edges.size() << " total edges" << std::endl;
-
-                // Flatten the list of pairs into a list of ints
-                edges.reserve(unique_edges.size() * 2);
-                for (const auto& [a, b] : unique_edges)
-                {
-                    edges.push_back(a);
-                    edges.push_back(b);
-                }
-            }
-        }
-        catch (std::exception e)
-        {
-            std::cout << e.what() << std::endl;
-        }
-
-        tetrahedra_groups.push_back({
-            vertices,
-            simplices,
-            edges,
-            normals
-        });
-    }
-    
-    return tetrahedra_groups;
-}
-
 int main()
 {
     initialize();
@@ -493,14 +307,26 @@ int main()
     const glm::vec4 origin = { 0.0f, 0.0f, 0.0f, 0.0f };
     const float pi = 3.14159265358979f;
 
-    auto tetrahedra_groups = run_qhull();
+    // Build all of the polychora on worker threads, so that the window opens immediately: each
+    // one is uploaded to the GPU as soon as it is ready
+    auto loader = four::Loader{};
+
+    // Maps each job ID to the index of the corresponding object in the renderer (or -1, if
+    // the job hasn't finished yet)
+    std::vector<int64_t> batch_indices;
+
+    // The index of the only object that is currently visible (see below)
+    int64_t visible_batch = -1;
+
+    // All of the uniform polychora that can be built on-demand (via Wythoff's construction)
+    const auto catalog = four::wythoff::get_catalog();
+
+    // The loader job (if any) that builds each entry of the catalog, so that each one is only built once
+    std::vector<int64_t> catalog_jobs(catalog.size(), -1);
 
     // Construct the 4D mesh, slicing hyperplane, 4D camera, etc.
-    auto renderer = four::Renderer{};
-    for (const auto& tetrahedra : tetrahedra_groups)
-    {
-        renderer.add_tetrahedra(tetrahedra);
-    }
+    // All of the polychora are normalized to unit radius, so they can use the compact vertex formats
+    auto renderer = four::Renderer{ four::Renderer::VertexFormat::COMPACT };
 
     auto hyperplane = four::Hyperplane{ w_axis, 0.1f };
     auto camera = four::Camera{
@@ -513,19 +339,74 @@ int main()
     // Load the shader program that will project 4D -> 3D -> 2D
     auto shader_projections = graphics::Shader{ "../shaders/projections.vert", "../shaders/projections.frag" };
 
-    // Perform the intial slicing
-    glm::mat4 simple_rotation_matrix = build_simple_rotation_matrix();
-    renderer.slice_objects(hyperplane);
+    auto orientation = build_orientation();
+
+    // When the rotations are reset, the objects are smoothly rotated back to their original orientation
+    const double reset_duration = 1.0;
+    double reset_start_time = -1.0;
+    four::maths::Rotor4 reset_start_orientation;
 
     // Uniforms for 4D -> 3D projection.
     shader_projections.use();
     shader_projections.uniform_vec4("u_four_from", camera.get_from());
-    shader_projections.uniform_mat4("u_four_model", simple_rotation_matrix); 
     shader_projections.uniform_mat4("u_four_view", camera.look_at());
     shader_projections.uniform_mat4("u_four_projection", camera.projection());
 
     // Uniforms for 3D -> 2D projection.
     shader_projections.uniform_mat4("u_three_view", arcball_camera_matrix);
+
+    const auto upload = [&](size_t id, const four::TetrahedraView& tetrahedra)
+    {
+        const size_t batch_index = renderer.get_number_of_objects();
+        renderer.add_tetrahedra(tetrahedra);
+        renderer.set_orientation(batch_index, orientation);
+        renderer.set_visible(batch_index, id == polychoron_index);
+
+        batch_indices.resize(loader.get_number_of_jobs(), -1);
+        batch_indices[id] = batch_index;
+    };
+
+    // Polychora that have been built before are mapped straight from the on-disk cache (skipping QHull
+    // entirely), while all of the others are built on a worker thread and then written to the cache: either
+    // way, they are uploaded by the frame loop (one per frame)
+    const auto load_or_submit = [&](const std::string& name, uint64_t key, std::function<std::vector<glm::vec4>(std::ostream&)> generate)
+    {
+        if (auto cached = four::cache::load(key))
+        {
+            auto storage = std::make_shared<const four::cache::CachedTetrahedra>(std::move(*cached));
+            return loader.submit_completed(name, storage->view, storage);
+        }
+
+        return loader.submit(name, [key, generate](const auto& report_progress, std::ostream& log)
+        {
+            auto tetrahedra = four::hull::build_tetrahedra(generate(log), true, log, report_progress);
+            if (!tetrahedra.simplices.empty())
+            {
+                try
+                {
+                    four::cache::save(key, tetrahedra);
+                }
+                catch (const std::exception& e)
+                {
+                    log << "\t" << "Could not write to the mesh cache: " << e.what() << std::endl;
+                }
+            }
+            return tetrahedra;
+        });
+    };
+
+    const auto all_permutation_seeds = four::get_all_permutation_seeds();
+    const auto all_permutation_seed_names = four::get_all_permutation_seed_names();
+    for (size_t i = 0; i < all_permutation_seeds.size(); ++i)
+    {
+        load_or_submit(all_permutation_seed_names[i], four::cache::get_key(all_permutation_seeds[i]), [seeds = all_permutation_seeds[i]](std::ostream& log)
+        {
+            auto permutations = four::combinatorics::generate(seeds);
+            log << "\t" << permutations.size() << " permutations found" << std::endl;
+
+            return permutations;
+        });
+    }
     
     while (!glfwWindowShouldClose(window))
     {
@@ -540,27 +421,109 @@ int main()
 
         bool topology_needs_update = false;
 
+        // Upload (at most) one finished polychoron per frame, so that the UI stays responsive
+        batch_indices.resize(loader.get_number_of_jobs(), -1);
+        four::LoadResult result;
+        if (loader.try_pop(result))
+        {
+            upload(result.id, result.view);
+            topology_needs_update = true;
+        }
+
         // Draw the UI elements (buttons, sliders, etc.)
         {
             ImGui::Begin("Settings"); 
             ImGui::ColorEdit3("Background Color", (float*)&clear_color);
             ImGui::Text("Application Average %.3f MS/Frame (%.1f FPS)", 1000.0f / ImGui::GetIO().Framerate, ImGui::GetIO().Framerate);
             ImGui::Separator();
-            ImGui::SliderInt("Polychoron Index", (int*)&polychoron_index, 0, renderer.get_number_of_objects() - 1);
+            ImGui::SliderInt("Polychoron Index", (int*)&polychoron_index, 0, loader.get_number_of_jobs() - 1);
+            ImGui::Text("%s", loader.get_progress(polychoron_index).name.c_str());
+            if (renderer.get_vertex_format() == four::Renderer::VertexFormat::COMPACT && 
+                polychoron_index < batch_indices.size() && 
+                batch_indices[polychoron_index] != -1)
+            {
+                // How far the compact vertex formats are from full-precision floats
+                const auto& report = renderer.get_precision_report(batch_indices[polychoron_index]);
+                ImGui::Text("Position Error: %.2e (Max), %.2e (RMS)", report.max_position_error, report.rms_position_error);
+                ImGui::Text("Slice Vertex Error: %.2e (Max)", report.max_slice_vertex_error);
+                ImGui::Text("Normal Error: %.2f Degrees (Max)", report.max_normal_error);
+            }
+            for (size_t i = 0; i < loader.get_number_of_jobs(); ++i)
+            {
+                // Only show progress bars for polychora that are still being built
+                const auto& progress = loader.get_progress(i);
+                if (progress.status == four::LoadStatus::QUEUED || progress.status == four::LoadStatus::BUILDING)
+                {
+                    ImGui::ProgressBar(progress.fraction, ImVec2(-1.0f, 0.0f), progress.name.c_str());
+                }
+            }
+            if (ImGui::BeginCombo("Uniform Polychora", catalog[catalog_index].name.c_str()))
+            {
+                for (size_t i = 0; i < catalog.size(); ++i)
+                {
+                    bool is_selected = catalog_index == i;
+                    if (ImGui::Selectable(catalog[i].name.c_str(), is_selected))
+                    {
+                        catalog_index = i;
+                    }
+                    if (is_selected)
+                    {
+                        ImGui::SetItemDefaultFocus();
+                    }
+                }
+                ImGui::EndCombo();
+            }
+            if (ImGui::Button("Build From Coxeter Diagram"))
+            {
+                // Generate the vertices via Wythoff's construction and add the resulting polychoron to the scene
+                // once it has been built (or simply select it again, unless the previous attempt failed)
+                auto& job = catalog_jobs[catalog_index];
+                if (job == -1 || loader.get_progress(job).status == four::LoadStatus::FAILED)
+                {
+                    const auto& entry = catalog[catalog_index];
+                    job = load_or_submit(entry.name, four::cache::get_key(entry), [entry](std::ostream&)
+                    {
+                        return four::wythoff::generate(entry);
+                    });
+                }
+                polychoron_index = job;
+            }
             ImGui::Text("Planar Rotations (in 4-Space)");
-            topology_needs_update |= ImGui::SliderFloat("XY", &rotation_xy, 0.0f, 2.0f * pi);
-            topology_needs_update |= ImGui::SliderFloat("YZ", &rotation_yz, 0.0f, 2.0f * pi);
-            topology_needs_update |= ImGui::SliderFloat("ZX", &rotation_zx, 0.0f, 2.0f * pi);
-            topology_needs_update |= ImGui::SliderFloat("XW", &rotation_xw, 0.0f, 2.0f * pi);
-            topology_needs_update |= ImGui::SliderFloat("YW", &rotation_yw, 0.0f, 2.0f * pi);
-            topology_needs_update |= ImGui::SliderFloat("ZW", &rotation_zw, 0.0f, 2.0f * pi);
-            if (topology_needs_update)
+            bool rotation_changed = false;
+            rotation_changed |= ImGui::SliderFloat("XY", &rotation_xy, 0.0f, 2.0f * pi);
+            rotation_changed |= ImGui::SliderFloat("YZ", &rotation_yz, 0.0f, 2.0f * pi);
+            rotation_changed |= ImGui::SliderFloat("ZX", &rotation_zx, 0.0f, 2.0f * pi);
+            rotation_changed |= ImGui::SliderFloat("XW", &rotation_xw, 0.0f, 2.0f * pi);
+            rotation_changed |= ImGui::SliderFloat("YW", &rotation_yw, 0.0f, 2.0f * pi);
+            rotation_changed |= ImGui::SliderFloat("ZW", &rotation_zw, 0.0f, 2.0f * pi);
+            if (ImGui::Button("Reset Rotations"))
             {
-                // Don't rebuild the rotation matrices unless we have to
-                simple_rotation_matrix = build_simple_rotation_matrix();
+                rotation_xy = rotation_yz = rotation_zx = rotation_xw = rotation_yw = rotation_zw = 0.0f;
+                reset_start_time = glfwGetTime();
+                reset_start_orientation = orientation;
+            }
+            if (rotation_changed)
+            {
+                // Don't rebuild the orientation unless we have to (this also cancels any reset that is in progress)
+                topology_needs_update = true;
+                reset_start_time = -1.0;
+                orientation = build_orientation();
                 
-                // All 4D objects receive the same 4-space rotation matrix                 
-                renderer.set_transforms(simple_rotation_matrix);
+                // All 4D objects receive the same 4-space orientation                 
+                renderer.set_orientations(orientation);
+            }
+            else if (reset_start_time >= 0.0)
+            {
+                const float t = static_cast<float>(std::min((glfwGetTime() - reset_start_time) / reset_duration, 1.0));
+                if (t >= 1.0f)
+                {
+                    reset_start_time = -1.0;
+                }
+
+                // Ease in and out of the (constant angular velocity) interpolation
+                orientation = four::maths::slerp(reset_start_orientation, four::maths::Rotor4::identity(), t * t * (3.0f - 2.0f * t));
+                renderer.set_orientations(orientation);
+                topology_needs_update = true;
             }
             ImGui::Separator();
             if (ImGui::BeginCombo("Display Mode", current_mode.c_str()))
@@ -591,6 +554,16 @@ int main()
                 }
 
                 ImGui::Checkbox("Display Wireframe", &display_wireframe);
+                if (ImGui::Checkbox("Slice Whole Cells", &slice_cells))
+                {
+                    renderer.set_slice_cells(slice_cells);
+                    topology_needs_update = true;
+                }
+                if (ImGui::Checkbox("Kinetic Slicing", &kinetic_slicing))
+                {
+                    renderer.set_kinetic_slicing(kinetic_slicing);
+                    topology_needs_update = true;
+                }
             }
             else
             {
@@ -604,32 +577,50 @@ int main()
         glClearColor(clear_color.x, clear_color.y, clear_color.z, clear_color.w);
         glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
 
-        // Draw the 4D objects
+        // Only the selected polychoron is drawn, so all of the others are hidden (which means that they are skipped while slicing)
+        const int64_t selected_batch = polychoron_index < batch_indices.size() ? batch_indices[polychoron_index] : -1;
+        if (selected_batch != visible_batch)
+        {
+            for (size_t i = 0; i < renderer.get_number_of_objects(); ++i)
+            {
+                renderer.set_visible(i, static_cast<int64_t>(i) == selected_batch);
+            }
+            visible_batch = selected_batch;
+            topology_needs_update = true;
+        }
+
+        // Objects that are out of view are skipped while slicing, so any that come into view need to be sliced
+        const auto three_projection = glm::perspective(glm::radians(zoom), static_cast<float>(window_w) / static_cast<float>(window_h), 0.1f, 1000.0f);
+        if (renderer.set_view(three_projection * arcball_camera_matrix * arcball_model_matrix))
         {
-            const auto three_projection = glm::perspective(glm::radians(zoom), static_cast<float>(window_w) / static_cast<float>(window_h), 0.1f, 1000.0f);
+            topology_needs_update = true;
+        }
+
+        // Re-slice the visible 4D objects (culling any that the hyperplane doesn't touch, or that are out of view)
+        if (current_mode == "Slice" && topology_needs_update)
+        {
+            renderer.slice_objects(hyperplane);
+        }
+
+        // Draw the 4D objects (if the currently selected one has finished loading)
+        if (polychoron_index < batch_indices.size() && batch_indices[polychoron_index] != -1)
+        {
+            const size_t batch_index = batch_indices[polychoron_index];
 
             if (current_mode == "Tetrahedra" || current_mode == "Edges")
             {
+                shader_projections.use();
                 shader_projections.uniform_float("u_clip_distance_w", clip_distance_w);
                 shader_projections.uniform_mat4("u_three_model", arcball_model_matrix);
                 shader_projections.uniform_mat4("u_three_projection", three_projection);
-                shader_projections.uniform_vec4("u_four_model_translation", renderer.get_translation(polychoron_index));
-                shader_projections.uniform_mat4("u_four_model_orientation", renderer.get_transform(polychoron_index));
                 shader_projections.uniform_bool("u_perspective_4D", true);
+                shader_projections.uniform_bool("u_primitive_colors", false);
 
                 // Draw either the edges of the polychoron or the wireframe outline of its tetrahedral decomposition
-                renderer.draw_skeleton_object(polychoron_index, current_mode == "Tetrahedra");
+                renderer.draw_skeleton_object(batch_index, current_mode == "Tetrahedra");
             }
             else
             {
-                if (topology_needs_update)
-                {
-                    for (size_t i = 0; i < renderer.get_number_of_objects(); i++)
-                    {
-                        renderer.slice_object(i, hyperplane);
-                    }
-                }
-
                 if (display_wireframe)
                 {
                     glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
@@ -649,7 +640,9 @@ int main()
                 shader_projections.uniform_mat4("u_three_model", arcball_model_matrix);
                 shader_projections.uniform_mat4("u_three_projection", three_projection);
                 shader_projections.uniform_bool("u_perspective_4D", false);
-                renderer.draw_sliced_object(polychoron_index);
+                shader_projections.uniform_bool("u_primitive_colors", true);
+                shader_projections.uniform_bool("u_compact", renderer.get_vertex_format() == four::Renderer::VertexFormat::COMPACT);
+                renderer.draw_sliced_object(batch_index);
             }
         }
 